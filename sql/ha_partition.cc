@@ -328,6 +328,10 @@ void ha_partition::init_handler_variables() {
   m_key_not_found = FALSE;
   auto_increment_lock = FALSE;
   auto_increment_safe_stmt_log_lock = FALSE;
+  m_auto_inc_lease_start = 0;
+  m_auto_inc_lease_next = 0;
+  m_auto_inc_lease_end = 0;
+  m_auto_inc_lease_version = 0;
   /*
     this allows blackhole to work properly
   */
@@ -352,6 +356,7 @@ void ha_partition::init_handler_variables() {
 
   m_pre_calling = FALSE;
   m_pre_call_use_parallel = FALSE;
+  m_ready_order_scan = FALSE;
 
   ft_first = ft_current = NULL;
   bulk_access_executing = FALSE;  // For future
@@ -365,6 +370,7 @@ void ha_partition::init_handler_variables() {
   my_bitmap_clear(&m_key_not_found_partitions);
   my_bitmap_clear(&m_mrr_used_partitions);
   my_bitmap_clear(&m_opened_partitions);
+  my_bitmap_clear(&m_ready_order_pending);
   m_file_sample = NULL;
 
 #ifdef DONT_HAVE_TO_BE_INITALIZED
@@ -2985,6 +2991,7 @@ void ha_partition::free_partition_bitmaps() {
   my_bitmap_free(&m_key_not_found_partitions);
   my_bitmap_free(&m_opened_partitions);
   my_bitmap_free(&m_mrr_used_partitions);
+  my_bitmap_free(&m_ready_order_pending);
 }
 
 /**
@@ -3026,6 +3033,13 @@ bool ha_partition::init_partition_bitmaps() {
   if (my_bitmap_init(&m_opened_partitions, NULL, m_tot_parts, FALSE))
     DBUG_RETURN(true);
 
+  /*
+    Initialize the bitmap we use to keep track of partitions not yet
+    exhausted by an unordered scan read in ready order.
+  */
+  if (my_bitmap_init(&m_ready_order_pending, NULL, m_tot_parts, FALSE))
+    DBUG_RETURN(true);
+
   m_file_sample = NULL;
 
   /* Initialize the bitmap for read/lock_partitions */
@@ -4073,6 +4087,7 @@ int ha_partition::truncate() {
     it so that it will be initialized again at the next use.
   */
   lock_auto_increment();
+  part_share->invalidate_auto_inc_leases();
   part_share->next_auto_inc_val = 0;
   part_share->auto_inc_initialized = false;
   part_share->last_insert_failed = false;
@@ -4113,6 +4128,7 @@ int ha_partition::truncate_partition(Alter_info *alter_info,
     it so that it will be initialized again at the next use.
   */
   lock_auto_increment();
+  part_share->invalidate_auto_inc_leases();
   part_share->next_auto_inc_val = 0;
   part_share->auto_inc_initialized = FALSE;
   part_share->last_insert_failed = FALSE;
@@ -4304,6 +4320,7 @@ int ha_partition::end_bulk_insert() {
     if (opt_spider_auto_increment_mode_switch &&
         is_spider_storage_engine()) {
       lock_auto_increment();
+      part_share->invalidate_auto_inc_leases();
       part_share->auto_inc_initialized = FALSE;
       part_share->last_insert_failed = TRUE;
       unlock_auto_increment();
@@ -4507,14 +4524,26 @@ int ha_partition::rnd_next(uchar *buf) {
   DBUG_ASSERT(m_scan_value == 1);
 
   if (m_rnd_init_and_first) {
+    bool use_parallel = check_parallel_search();
     m_rnd_init_and_first = FALSE;
-    error = handle_pre_scan(FALSE, check_parallel_search());
+    error = handle_pre_scan(FALSE, use_parallel);
+    if (!error) start_ready_order_scan(use_parallel);
     if (m_pre_calling || error) DBUG_RETURN(error);
   }
 
   file = m_file[part_id];
 
   while (TRUE) {
+    if (m_ready_order_scan && !file->pre_scan_ready()) {
+      /* Read another partition while this one waits for its rows */
+      uint ready_part = get_ready_order_part(part_id);
+      if (ready_part != part_id) {
+        late_extra_no_cache(part_id);
+        part_id = ready_part;
+        file = m_file[part_id];
+        late_extra_cache(part_id);
+      }
+    }
     result = file->ha_rnd_next(buf);
     if (!result) {
       m_last_part = part_id;
@@ -4533,7 +4562,7 @@ int ha_partition::rnd_next(uchar *buf) {
     /* End current partition */
     late_extra_no_cache(part_id);
     /* Shift to next partition */
-    part_id = bitmap_get_next_set(&m_part_info->read_partitions, part_id);
+    part_id = next_unordered_scan_part(part_id);
     if (part_id >= m_tot_parts) {
       result = HA_ERR_END_OF_FILE;
       break;
@@ -5116,8 +5145,9 @@ int ha_partition::common_first_last(uchar *buf) {
 
   if (unlikely((error = partition_scan_set_up(buf, FALSE)))) return error;
   if (!m_ordered_scan_ongoing && m_index_scan_type != partition_index_last) {
-    if (unlikely((error = handle_pre_scan(FALSE, check_parallel_search()))))
-      return error;
+    bool use_parallel = check_parallel_search();
+    if (unlikely((error = handle_pre_scan(FALSE, use_parallel)))) return error;
+    start_ready_order_scan(use_parallel);
     return handle_unordered_scan_next_partition(buf);
   }
   return handle_ordered_index_scan(buf, FALSE);
@@ -5444,7 +5474,7 @@ int ha_partition::multi_range_key_create_key(RANGE_SEQ_IF *seq,
     m_mrr_range_current->ptr = m_mrr_range_current->key_multi_range.ptr;
     m_mrr_range_current->key_multi_range.ptr = m_mrr_range_current;
 
-    if (start_key->key && (start_key->flag & HA_READ_KEY_EXACT))
+    if (start_key->key && start_key->flag == HA_READ_KEY_EXACT)
       get_partition_set(table, table->record[0], active_index, start_key,
                         &m_part_spec);
     else {
@@ -5778,6 +5808,15 @@ int ha_partition::multi_range_read_next(range_id_t *range_info) {
     *range_info = m_mrr_range_current->ptr;
   } else {
     if (unlikely(m_multi_range_read_first)) {
+      /*
+        Send the ranges of every used partition before reading the first
+        one, so that partitions able to run in parallel do it.
+      */
+      bool use_parallel =
+          m_pre_calling ? m_pre_call_use_parallel : check_parallel_search();
+      if (unlikely((error = handle_pre_scan(FALSE, use_parallel))))
+        DBUG_RETURN(error);
+      start_ready_order_scan(use_parallel);
       if (unlikely(
               (error = handle_unordered_scan_next_partition(table->record[0]))))
         DBUG_RETURN(error);
@@ -6341,6 +6380,7 @@ int ha_partition::handle_pre_scan(bool reverse_order, bool use_parallel) {
   DBUG_PRINT("enter",
              ("m_part_spec.start_part: %u  m_part_spec.end_part: %u",
               (uint)m_part_spec.start_part, (uint)m_part_spec.end_part));
+  m_ready_order_scan = FALSE;
   thd_proc_info(0, "spider pre_scan start");
   for (i = m_part_spec.start_part; i <= m_part_spec.end_part; i++) {
     if (!(bitmap_is_set(&(m_part_info->read_partitions), i))) continue;
@@ -6389,6 +6429,61 @@ int ha_partition::handle_pre_scan(bool reverse_order, bool use_parallel) {
   DBUG_RETURN(0);
 }
 
+/*
+  Start reading an unordered scan in ready order
+
+  SYNOPSIS
+    start_ready_order_scan()
+    use_parallel              The pre-calls were run in parallel
+
+  DESCRIPTION
+    With spider_parallel_unordered_scan, a partition whose pre-called
+    result has already arrived is read before a partition that is still
+    waiting for its remote server. Rows of an unordered scan have no
+    order, so only the latency of the slowest partition changes.
+*/
+
+void ha_partition::start_ready_order_scan(bool use_parallel) {
+  uint i;
+  DBUG_ENTER("ha_partition::start_ready_order_scan");
+  m_ready_order_scan = opt_spider_parallel_unordered_scan && use_parallel;
+  if (m_ready_order_scan) {
+    bitmap_clear_all(&m_ready_order_pending);
+    for (i = m_part_spec.start_part;
+         i <= m_part_spec.end_part && i < m_tot_parts; i++) {
+      if (bitmap_is_set(&(m_part_info->read_partitions), i))
+        bitmap_set_bit(&m_ready_order_pending, i);
+    }
+  }
+  DBUG_VOID_RETURN;
+}
+
+/*
+  Return the first pending partition whose next row is already fetched,
+  or part_id if no partition is ready.
+*/
+
+uint ha_partition::get_ready_order_part(uint part_id) {
+  uint i;
+  for (i = bitmap_get_first_set(&m_ready_order_pending); i < m_tot_parts;
+       i = bitmap_get_next_set(&m_ready_order_pending, i)) {
+    if (m_file[i]->pre_scan_ready()) return i;
+  }
+  return part_id;
+}
+
+/*
+  Return the partition to read after part_id is exhausted, or a value
+  >= m_tot_parts when the scan is over.
+*/
+
+uint ha_partition::next_unordered_scan_part(uint part_id) {
+  if (!m_ready_order_scan)
+    return bitmap_get_next_set(&m_part_info->read_partitions, part_id);
+  bitmap_clear_bit(&m_ready_order_pending, part_id);
+  return get_ready_order_part(bitmap_get_first_set(&m_ready_order_pending));
+}
+
 /****************************************************************************
   Unordered Index Scan Routines
 ****************************************************************************/
@@ -6457,6 +6552,8 @@ int ha_partition::handle_unordered_next(uchar *buf, bool is_next_same) {
   }
 
   if (unlikely(error == HA_ERR_END_OF_FILE)) {
+    if (m_ready_order_scan)
+      bitmap_clear_bit(&m_ready_order_pending, m_part_spec.start_part);
     m_part_spec.start_part++;  // Start using next part
     error = handle_unordered_scan_next_partition(buf);
   }
@@ -6486,13 +6583,14 @@ int ha_partition::handle_unordered_scan_next_partition(uchar *buf) {
   DBUG_ENTER("ha_partition::handle_unordered_scan_next_partition");
 
   /* Read next partition that includes start_part */
-  if (i)
+  if (m_ready_order_scan)
+    i = get_ready_order_part(bitmap_get_first_set(&m_ready_order_pending));
+  else if (i)
     i = bitmap_get_next_set(&m_part_info->read_partitions, i - 1);
   else
     i = bitmap_get_first_set(&m_part_info->read_partitions);
 
-  for (; i <= m_part_spec.end_part;
-       i = bitmap_get_next_set(&m_part_info->read_partitions, i)) {
+  for (; i <= m_part_spec.end_part; i = next_unordered_scan_part(i)) {
     int error;
     handler *file = m_file[i];
     m_part_spec.start_part = i;
@@ -9198,6 +9296,7 @@ int ha_partition::reset_auto_increment(ulonglong value) {
   int res;
   DBUG_ENTER("ha_partition::reset_auto_increment");
   lock_auto_increment();
+  part_share->invalidate_auto_inc_leases();
   part_share->auto_inc_initialized = false;
   part_share->last_insert_failed = false;
   part_share->next_auto_inc_val = 0;
@@ -9258,10 +9357,38 @@ void ha_partition::get_auto_increment(ulonglong offset, ulonglong increment,
     *nb_reserved_values = 1;
   } else {
     THD *thd = ha_thd();
+    bool use_lease = FALSE;
     /*
       This is initialized in the beginning of the first write_row call.
     */
     DBUG_ASSERT(part_share->auto_inc_initialized);
+
+    /*
+      With spider auto_increment, values are leased to this handler in
+      ranges of spider_auto_increment_lease_size, so most rows are served
+      without the part_share mutex. Statement based binlog needs the
+      values of a multi-row statement to be consecutive, so leasing is
+      only used when that does not apply.
+    */
+    if (opt_spider_auto_increment_mode_switch && is_spider_storage_engine() &&
+        opt_spider_auto_increment_lease_size > 1 &&
+        !auto_increment_safe_stmt_log_lock &&
+        (thd->lex->sql_command == SQLCOM_INSERT ||
+         !mysql_bin_log.is_open() || thd->is_current_stmt_binlog_format_row() ||
+         !(thd->variables.option_bits & OPTION_BIN_LOG))) {
+      use_lease = TRUE;
+      if (auto_inc_lease_is_valid() &&
+          m_auto_inc_lease_next + nb_desired_values *
+                                      opt_spider_auto_increment_step <=
+              m_auto_inc_lease_end) {
+        *first_value = m_auto_inc_lease_next;
+        m_auto_inc_lease_next +=
+            nb_desired_values * opt_spider_auto_increment_step;
+        *nb_reserved_values = nb_desired_values;
+        DBUG_PRINT("info", ("*first_value: %lu from lease", (ulong)*first_value));
+        DBUG_VOID_RETURN;
+      }
+    }
     /*
       Get a lock for handling the auto_increment in part_share
       for avoiding two concurrent statements getting the same number.
@@ -9297,10 +9424,25 @@ void ha_partition::get_auto_increment(ulonglong offset, ulonglong increment,
     }
     /* this gets corrected (for offset/increment) in update_auto_increment */
     *first_value = part_share->next_auto_inc_val;
-    if (opt_spider_auto_increment_mode_switch && is_spider_storage_engine())
+    if (use_lease) {
+      /* lease a whole range, the rest is served by the next calls */
+      m_auto_inc_lease_version =
+          my_atomic_load64(&part_share->auto_inc_lease_version);
+      m_auto_inc_lease_start = *first_value;
+      m_auto_inc_lease_next =
+          *first_value + nb_desired_values * opt_spider_auto_increment_step;
+      m_auto_inc_lease_end =
+          *first_value + MY_MAX(nb_desired_values,
+                                opt_spider_auto_increment_lease_size) *
+                             opt_spider_auto_increment_step;
+      part_share->next_auto_inc_val = m_auto_inc_lease_end;
+    } else if (opt_spider_auto_increment_mode_switch &&
+               is_spider_storage_engine()) {
+      /* the statement holds the mutex itself, drop any earlier lease */
+      m_auto_inc_lease_end = 0;
       part_share->next_auto_inc_val +=
           nb_desired_values * opt_spider_auto_increment_step;
-    else
+    } else
       part_share->next_auto_inc_val += nb_desired_values * increment;
 
     unlock_auto_increment();
@@ -9320,7 +9462,8 @@ void ha_partition::release_auto_increment() {
          i = bitmap_get_next_set(&m_part_info->lock_partitions, i)) {
       m_file[i]->ha_release_auto_increment();
     }
-  } else if (next_insert_id) {
+  } else if (next_insert_id && !auto_inc_lease_is_valid()) {
+    /* unused values of a leased range stay with this handler */
     ulonglong next_auto_inc_val;
     lock_auto_increment();
     next_auto_inc_val = part_share->next_auto_inc_val;
@@ -10084,6 +10227,66 @@ int ha_partition::direct_update_rows(ha_rows *update_rows_result,
   DBUG_RETURN(0);
 }
 
+/**
+  Check if the LIMIT of a direct delete can be split across the
+  partitions. Without ORDER BY any rows may be picked, so each partition
+  gets a share of the budget and the partitions run at the same time.
+  Direct updates keep the sequential path: an updated row still matches
+  the WHERE clause, so a second pass over a partition could apply a
+  non-idempotent SET to it again.
+
+  SYNOPSIS
+    direct_limit_split_ok()
+
+  RETURN VALUE
+    TRUE                      Split the limit
+    FALSE                     Run the partitions one after another
+*/
+
+bool ha_partition::direct_limit_split_ok() {
+  THD *thd = ha_thd();
+  DBUG_ENTER("ha_partition::direct_limit_split_ok");
+  DBUG_RETURN(thd && thd->direct_limit > 0 &&
+              !thd->lex->select_lex.order_list.elements);
+}
+
+/**
+  Split the limit evenly across the target partitions. Partitions
+  with a lower index get the remainder.
+
+  SYNOPSIS
+    direct_limit_split()
+    limit                     Rows allowed for the whole statement
+
+  RETURN VALUE
+    NULL                      Out of memory
+    != NULL                   Per partition budgets, indexed by part id
+*/
+
+longlong *ha_partition::direct_limit_split(longlong limit) {
+  THD *thd = ha_thd();
+  uint parts = 0, part_no = 0;
+  uint32 i;
+  longlong *quota;
+  DBUG_ENTER("ha_partition::direct_limit_split");
+
+  if (!(quota = (longlong *)thd->calloc(sizeof(longlong) * m_tot_parts)))
+    DBUG_RETURN(NULL);
+  for (i = bitmap_get_first_set(&m_part_info->read_partitions); i < m_tot_parts;
+       i = bitmap_get_next_set(&m_part_info->read_partitions, i)) {
+    if (bitmap_is_set(&(m_part_info->lock_partitions), i)) parts++;
+  }
+  for (i = bitmap_get_first_set(&m_part_info->read_partitions); i < m_tot_parts;
+       i = bitmap_get_next_set(&m_part_info->read_partitions, i)) {
+    if (bitmap_is_set(&(m_part_info->lock_partitions), i)) {
+      quota[i] = limit / parts + (part_no < limit % parts ? 1 : 0);
+      DBUG_PRINT("info", ("partition part %u quota=%lld", i, quota[i]));
+      part_no++;
+    }
+  }
+  DBUG_RETURN(quota);
+}
+
 /**
   Start parallel execution of a direct update for a handlersocket update
   request.  A direct update request updates all qualified rows in a single
@@ -10225,6 +10428,9 @@ int ha_partition::direct_delete_rows(ha_rows *delete_rows_result) {
 
   *delete_rows_result = 0;
   m_part_spec = m_direct_update_part_spec;
+  if (!m_pre_calling && direct_limit_split_ok())
+    DBUG_RETURN(direct_delete_rows_with_limit(rnd_seq, delete_rows_result));
+
   for (i = bitmap_get_first_set(&m_part_info->read_partitions); i < m_tot_parts;
        i = bitmap_get_next_set(&m_part_info->read_partitions, i)) {
     file = m_file[i];
@@ -10274,6 +10480,117 @@ int ha_partition::direct_delete_rows(ha_rows *delete_rows_result) {
   DBUG_RETURN(0);
 }
 
+/**
+  Execute a direct delete on one partition within thd->direct_limit.
+
+  SYNOPSIS
+    direct_delete_part()
+    part_id                   Partition to delete from
+    rnd_seq                   The partition is scanned with rnd_init
+    delete_rows               Number of deleted rows
+
+  RETURN VALUE
+    >0                        Error
+    0                         Success
+*/
+
+int ha_partition::direct_delete_part(uint32 part_id, bool rnd_seq,
+                                     ha_rows *delete_rows) {
+  int error;
+  handler *file = m_file[part_id];
+  DBUG_ENTER("ha_partition::direct_delete_part");
+
+  *delete_rows = 0;
+  if (rnd_seq && file->inited == NONE &&
+      unlikely((error = file->ha_rnd_init(TRUE))))
+    DBUG_RETURN(error);
+  if (unlikely((error = file->ha_direct_delete_rows(delete_rows)))) {
+    if (rnd_seq) file->ha_rnd_end();
+    DBUG_RETURN(error);
+  }
+  if (rnd_seq && unlikely((error = file->ha_index_or_rnd_end())))
+    DBUG_RETURN(error);
+  DBUG_RETURN(0);
+}
+
+/**
+  Execute a direct delete with LIMIT and without ORDER BY on several
+  partitions. The first pass gives each partition an even share of the
+  limit and lets them run in parallel. Partitions that used up their
+  share may hold more rows, so a follow-up pass visits them one by one
+  with what is left of the limit. Deleted rows no longer match, so the
+  follow-up pass never touches a row twice.
+
+  SYNOPSIS
+    direct_delete_rows_with_limit()
+    rnd_seq                   The partitions are scanned with rnd_init
+    delete_rows_result        Number of deleted rows
+
+  RETURN VALUE
+    >0                        Error
+    0                         Success
+*/
+
+int ha_partition::direct_delete_rows_with_limit(bool rnd_seq,
+                                                ha_rows *delete_rows_result) {
+  int error;
+  THD *thd = ha_thd();
+  longlong limit = thd->direct_limit;
+  longlong *quota;
+  ha_rows *part_deleted;
+  ha_rows delete_rows;
+  uint32 i;
+  DBUG_ENTER("ha_partition::direct_delete_rows_with_limit");
+
+  if (!(quota = direct_limit_split(limit)) ||
+      !(part_deleted = (ha_rows *)thd->calloc(sizeof(ha_rows) * m_tot_parts)))
+    DBUG_RETURN(HA_ERR_OUT_OF_MEM);
+
+  for (i = bitmap_get_first_set(&m_part_info->read_partitions); i < m_tot_parts;
+       i = bitmap_get_next_set(&m_part_info->read_partitions, i)) {
+    if (!quota[i]) continue;
+    thd->direct_limit = quota[i];
+    if ((error = direct_delete_part(i, rnd_seq, &delete_rows)))
+      DBUG_RETURN(error);
+    if (m_file[i]->ha_get_result_list_bg_phase() <= 0) {
+      *delete_rows_result += delete_rows;
+      part_deleted[i] = delete_rows;
+    }
+  }
+  for (i = bitmap_get_first_set(&m_part_info->read_partitions); i < m_tot_parts;
+       i = bitmap_get_next_set(&m_part_info->read_partitions, i)) {
+    if (!quota[i] || m_file[i]->ha_get_result_list_bg_phase() <= 0) continue;
+    delete_rows = 0;
+    if ((error = m_file[i]->ha_get_bg_result(&delete_rows)))
+      DBUG_RETURN(error);
+    *delete_rows_result += delete_rows;
+    part_deleted[i] = delete_rows;
+  }
+
+  limit -= *delete_rows_result;
+  for (i = bitmap_get_first_set(&m_part_info->read_partitions);
+       i < m_tot_parts && limit > 0;
+       i = bitmap_get_next_set(&m_part_info->read_partitions, i)) {
+    if (!bitmap_is_set(&(m_part_info->lock_partitions), i) ||
+        (longlong)part_deleted[i] < quota[i])
+      continue;
+    DBUG_PRINT("info", ("partition follow-up part %u limit=%lld", i, limit));
+    thd->direct_limit = limit;
+    if ((error = direct_delete_part(i, rnd_seq, &delete_rows)))
+      DBUG_RETURN(error);
+    if (m_file[i]->ha_get_result_list_bg_phase() > 0) {
+      delete_rows = 0;
+      if ((error = m_file[i]->ha_get_bg_result(&delete_rows)))
+        DBUG_RETURN(error);
+    }
+    *delete_rows_result += delete_rows;
+    limit -= delete_rows;
+  }
+  thd->direct_limit = limit;
+  bitmap_clear_all(&(m_part_info->lock_partitions));
+  DBUG_RETURN(0);
+}
+
 /**
   Start parallel execution of a direct delete for a handlersocket delete
   request.  A direct delete request deletes all qualified rows in a single
@@ -10324,6 +10641,17 @@ int ha_partition::info_push(uint info_type, void *info) {
   DBUG_RETURN(error);
 }
 
+longlong ha_partition::dup_resolved_rows() {
+  longlong rows = 0;
+  uint i;
+  DBUG_ENTER("ha_partition::dup_resolved_rows");
+
+  for (i = bitmap_get_first_set(&m_part_info->lock_partitions); i < m_tot_parts;
+       i = bitmap_get_next_set(&m_part_info->lock_partitions, i))
+    rows += m_file[i]->dup_resolved_rows();
+  DBUG_RETURN(rows);
+}
+
 void ha_partition::clear_top_table_fields() {
   handler **file;
   DBUG_ENTER("ha_partition::clear_top_table_fields");
@@ -10398,6 +10726,11 @@ bool ha_partition::is_spider_config_table() {
   DBUG_RETURN(is_config_table);
 }
 
+double ha_partition::collect_stats_sample_fraction() {
+  DBUG_ENTER("ha_partition::collect_stats_sample_fraction");
+  DBUG_RETURN((*m_file)->collect_stats_sample_fraction());
+}
+
 struct st_mysql_storage_engine partition_storage_engine = {
     MYSQL_HANDLERTON_INTERFACE_VERSION};
 
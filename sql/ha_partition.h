@@ -93,6 +93,10 @@ class Partition_share : public Handler_share
   bool last_insert_failed;                     /**< last auto_inc insert failed */
   mysql_mutex_t auto_inc_mutex;                /**< protecting auto_inc val */
   ulonglong next_auto_inc_val;                 /**< first non reserved value */
+  /** bumped to invalidate the auto_inc ranges leased by handlers */
+  volatile int64 auto_inc_lease_version;
+  /** no valid lease holds values below this, see invalidate_auto_inc_leases */
+  ulonglong auto_inc_lease_floor;
   /**
     Hash of partition names. Initialized in the first ha_partition::open()
     for the table_share. After that it is read-only, i.e. no locking required.
@@ -105,6 +109,8 @@ class Partition_share : public Handler_share
     : auto_inc_initialized(false),
     last_insert_failed(false),
     next_auto_inc_val(0),
+    auto_inc_lease_version(0),
+    auto_inc_lease_floor(0),
     partition_name_hash_initialized(false),
     partition_names(NULL)
   {
@@ -149,6 +155,16 @@ class Partition_share : public Handler_share
   {
     mysql_mutex_unlock(&auto_inc_mutex);
   }
+  /**
+    Invalidate the auto increment ranges leased by all handlers, called
+    with auto_inc_mutex locked whenever next_auto_inc_val is reset or
+    moved past values which may already be leased.
+  */
+  inline void invalidate_auto_inc_leases()
+  {
+    my_atomic_add64(&auto_inc_lease_version, 1);
+    auto_inc_lease_floor= next_auto_inc_val;
+  }
   /**
     Populate partition_name_hash with partition and subpartition names
     from part_info.
@@ -359,6 +375,14 @@ class ha_partition :public handler
     This to ensure it will work with statement based replication.
   */
   bool auto_increment_safe_stmt_log_lock;
+  /**
+    Range of spider auto_increment values leased by this handler from
+    part_share, see spider_auto_increment_lease_size.
+  */
+  ulonglong m_auto_inc_lease_start;
+  ulonglong m_auto_inc_lease_next;
+  ulonglong m_auto_inc_lease_end;
+  int64 m_auto_inc_lease_version;
   /** For optimizing ha_start_bulk_insert calls */
   MY_BITMAP m_bulk_insert_started;
   ha_rows   m_bulk_inserted_rows;
@@ -367,6 +391,10 @@ class ha_partition :public handler
   part_id_range m_direct_update_part_spec;
   bool                m_pre_calling;
   bool                m_pre_call_use_parallel;
+  /* read partitions in the order their pre-called results arrive */
+  bool                m_ready_order_scan;
+  /* partitions of the ready order scan which are not exhausted yet */
+  MY_BITMAP           m_ready_order_pending;
   /* Keep track of bulk access requests */
   bool                bulk_access_executing;
 
@@ -640,6 +668,10 @@ class ha_partition :public handler
 private:
   ha_rows guess_bulk_insert_rows();
   void start_part_bulk_insert(THD *thd, uint part_id);
+  bool direct_limit_split_ok();
+  longlong *direct_limit_split(longlong limit);
+  int direct_delete_part(uint32 part_id, bool rnd_seq, ha_rows *delete_rows);
+  int direct_delete_rows_with_limit(bool rnd_seq, ha_rows *delete_rows_result);
   long estimate_read_buffer_size(long original_size);
 public:
 
@@ -823,6 +855,9 @@ class ha_partition :public handler
   int partition_scan_set_up(uchar * buf, bool idx_read_flag);
   bool check_parallel_search();
   int handle_pre_scan(bool reverse_order, bool use_parallel);
+  void start_ready_order_scan(bool use_parallel);
+  uint get_ready_order_part(uint part_id);
+  uint next_unordered_scan_part(uint part_id);
   int handle_unordered_next(uchar * buf, bool next_same);
   int handle_unordered_scan_next_partition(uchar * buf);
   int handle_ordered_index_scan(uchar * buf, bool reverse_order);
@@ -1282,6 +1317,10 @@ class ha_partition :public handler
   {
     ulonglong nr= (((Field_num*) field)->unsigned_flag ||
                    field->val_int() > 0) ? field->val_int() : 0;
+    /* values this handler already served from its lease need no lock */
+    if (!error && nr >= m_auto_inc_lease_start &&
+        nr < m_auto_inc_lease_next && auto_inc_lease_is_valid())
+      return;
     lock_auto_increment();
     //DBUG_ASSERT(part_share->auto_inc_initialized || !can_use_for_auto_inc_init());
     /* must check when the mutex is taken */
@@ -1295,6 +1334,17 @@ class ha_partition :public handler
         }
         else
             part_share->next_auto_inc_val = nr + 1;
+        part_share->invalidate_auto_inc_leases();
+    }
+    else if (!error && opt_spider_auto_increment_mode_switch &&
+             is_spider_storage_engine() &&
+             nr >= part_share->auto_inc_lease_floor)
+    {
+      /*
+        An explicit value which may lie in a range leased by some handler
+        but not served yet, so nobody may hand it out again.
+      */
+      part_share->invalidate_auto_inc_leases();
     }
     /* whatever error occurred, set last_insert_failed as TRUE */
     if (opt_spider_auto_increment_mode_switch && is_spider_storage_engine() && error)
@@ -1304,9 +1354,18 @@ class ha_partition :public handler
           "AUTO_INCREMENT: set last_insert_failed=true, error number is %d",
           error);
         part_share->auto_inc_initialized = FALSE;
+        part_share->invalidate_auto_inc_leases();
     }
     unlock_auto_increment();
   }
+  /** whether the auto_inc range leased by this handler can be used */
+  bool auto_inc_lease_is_valid()
+  {
+    return m_auto_inc_lease_end &&
+           opt_spider_auto_increment_mode_switch &&
+           m_auto_inc_lease_version ==
+               my_atomic_load64(&part_share->auto_inc_lease_version);
+  }
 
 public:
 
@@ -1433,7 +1492,9 @@ class ha_partition :public handler
     virtual bool is_spider_storage_engine();
     virtual int  get_share_version_err(int64 cur_version, int64 newest_version, int error);
     virtual bool is_spider_config_table();
+    virtual double collect_stats_sample_fraction();
     virtual int info_push(uint info_type, void *info);
+    virtual longlong dup_resolved_rows();
 
     private:
     int handle_opt_partitions(THD *thd, HA_CHECK_OPT *check_opt, uint flags);
@@ -3409,6 +3409,12 @@ class handler :public Sql_alloc
    { return 0; }
   virtual int pre_rnd_next(bool use_parallel)
    { return 0; }
+  /*
+    TRUE if the next row of a pre-called scan can be returned without
+    waiting for a remote server
+  */
+  virtual bool pre_scan_ready()
+   { return TRUE; }
   int ha_pre_rnd_init(bool scan)
   {
     int result;
@@ -3975,6 +3981,16 @@ class handler :public Sql_alloc
  */
  virtual int info_push(uint info_type, void *info) { return 0; };
 
+ /**
+   Return how far the affected rows of the current INSERT ... ON DUPLICATE
+   KEY UPDATE or REPLACE differ from the rows the server saw as plainly
+   written, for engines that resolve the duplicates on their own (e.g. on
+   a remote server). Positive for rows updated or replaced, negative for
+   rows an upsert left unchanged, so that the affected rows returned to
+   the client stay correct.
+ */
+ virtual longlong dup_resolved_rows() { return 0; };
+
  /**
     This function is used to get correlating of a parent (table/column)
     and children (table/column). When conditions are pushed down to child
@@ -4220,6 +4236,15 @@ virtual bool is_spider_config_table()
 {
     return false;
 }
+/**
+  Fraction of the rows returned by the scans that collect
+  engine-independent statistics. Engines that sample rows on a remote
+  server return less than 1 so that the table cardinality is scaled up.
+*/
+virtual double collect_stats_sample_fraction()
+{
+    return 1.0;
+}
 /**
 wait and get the result of background thread
 */
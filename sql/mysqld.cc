@@ -418,6 +418,7 @@ my_bool opt_log_sql_use_mutil_partition;
 my_bool opt_spider_auto_increment_mode_switch;
 uint opt_spider_auto_increment_step;
 uint opt_spider_auto_increment_mode_value;
+uint opt_spider_auto_increment_lease_size;
 my_bool opt_spider_ignore_single_select_index;
 my_bool opt_spider_ignore_single_update_index;
 my_bool opt_spider_group_by_handler;
@@ -433,6 +434,7 @@ uint opt_spider_status_least;
 my_bool opt_spider_not_convert_binary;
 my_bool opt_spider_parallel_group_order;
 my_bool opt_spider_parallel_limit;
+my_bool opt_spider_parallel_unordered_scan;
 my_bool opt_spider_internal_xa;
 ulonglong opt_spider_log_ignore_err_nums;
 /*
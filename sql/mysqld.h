@@ -317,6 +317,7 @@ extern my_bool opt_log_sql_use_mutil_partition;
 extern my_bool opt_spider_auto_increment_mode_switch;
 extern uint opt_spider_auto_increment_mode_value;
 extern uint opt_spider_auto_increment_step;
+extern uint opt_spider_auto_increment_lease_size;
 extern my_bool opt_spider_ignore_single_select_index;
 extern my_bool opt_spider_ignore_single_update_index;
 extern my_bool opt_spider_group_by_handler;
@@ -332,6 +333,7 @@ extern uint opt_spider_status_least;
 extern my_bool opt_spider_not_convert_binary;
 extern my_bool opt_spider_parallel_group_order;
 extern my_bool opt_spider_parallel_limit;
+extern my_bool opt_spider_parallel_unordered_scan;
 extern my_bool opt_spider_internal_xa;
 
 #ifdef HAVE_PSI_INTERFACE
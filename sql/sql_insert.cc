@@ -620,6 +620,32 @@ static void save_insert_query_plan(THD *thd, TABLE_LIST *table_list) {
   }
 }
 
+/*
+  Fold the duplicates an engine resolved on its own (see
+  handler::dup_resolved_rows()) into the statement counters, so that a
+  pushed down upsert reports the same affected rows as a local one.
+*/
+
+static void add_dup_resolved_rows(TABLE *table, COPY_INFO *info) {
+  longlong rows;
+  if (info->handle_duplicates != DUP_UPDATE &&
+      info->handle_duplicates != DUP_REPLACE)
+    return;
+  if (!(rows = table->file->dup_resolved_rows())) return;
+  if (info->handle_duplicates == DUP_UPDATE) {
+    if (rows > 0) {
+      /* rows updated to new values count twice */
+      info->stats.updated += rows;
+      info->stats.touched += rows;
+    } else {
+      /* rows left unchanged count as not affected */
+      info->stats.copied -= MY_MIN(info->stats.copied, (ha_rows)-rows);
+      info->stats.touched += (ha_rows)-rows;
+    }
+  } else if (rows > 0)
+    info->stats.deleted += rows;
+}
+
 Field **TABLE::field_to_fill() {
   return triggers && triggers->nullable_fields() ? triggers->nullable_fields()
                                                  : field;
@@ -1095,6 +1121,7 @@ bool mysql_insert(THD *thd, TABLE_LIST *table_list, List<Item> &fields,
       table->file->print_error(my_errno, MYF(0));
       error = 1;
     }
+    if (likely(!error)) add_dup_resolved_rows(table, &info);
     if (duplic != DUP_ERROR || ignore)
       table->file->extra(HA_EXTRA_NO_IGNORE_DUP_KEY);
 
@@ -3676,6 +3703,7 @@ bool select_insert::prepare_eof() {
   if (likely(!error) && unlikely(thd->is_error()))
     error = thd->get_stmt_da()->sql_errno();
 
+  if (likely(!error)) add_dup_resolved_rows(table, &info);
   table->file->extra(HA_EXTRA_NO_IGNORE_DUP_KEY);
   table->file->extra(HA_EXTRA_WRITE_CANNOT_REPLACE);
 
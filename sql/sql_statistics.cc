@@ -325,7 +325,7 @@ class Column_statistics_collected :public Column_statistics
 
   inline void init(THD *thd, Field * table_field);
   inline bool add(ha_rows rowno);
-  inline void finish(ha_rows rows); 
+  inline void finish(ha_rows rows, double sample_fraction); 
   inline void cleanup();
 };
 
@@ -1745,6 +1745,26 @@ class Count_distinct_field_bit: public Count_distinct_field
 };
 
 
+/**
+  @brief
+  Scale up an average frequency counted on a sample of the table rows
+
+  @details
+  A value seen k times in a sample that has the fraction f of the rows
+  occurs about k/f times in the table, while values that are unique in
+  the table stay unique in the sample. The estimate 1 + (k - 1) / f
+  keeps both ends right.
+*/
+
+static inline
+double scale_sampled_avg_frequency(double val, double sample_fraction)
+{
+  if (val <= 1.0 || sample_fraction >= 1.0)
+    return val;
+  return 1.0 + (val - 1.0) / sample_fraction;
+}
+
+
 /* 
   The class Index_prefix_calc is a helper class used to calculate the values
   for the column 'avg_frequency' of the statistical table index_stats.
@@ -1902,7 +1922,7 @@ class Index_prefix_calc: public Sql_alloc
     avg_frequency[k-1] is set to 0, i.e. is considered as unknown.
   */
 
-  void get_avg_frequency()
+  void get_avg_frequency(double sample_fraction)
   {
     uint i;
     Prefix_calc_state *state;
@@ -1919,7 +1939,8 @@ class Index_prefix_calc: public Sql_alloc
       {
         double val= state->prefix_count == 0 ?
 	            0 : (double) state->entry_count / state->prefix_count;                     
-        index_info->collected_stats->set_avg_frequency(i, val);
+        index_info->collected_stats->set_avg_frequency(i,
+          scale_sampled_avg_frequency(val, sample_fraction));
       }
     }
   }       
@@ -2507,11 +2528,12 @@ bool Column_statistics_collected::add(ha_rows rowno)
   Get the results of aggregation when collecting the statistics on a column
   
   @param
-  rows          The total number of rows in the table 
+  rows             The total number of rows in the table 
+  sample_fraction  The fraction of the table rows that were read
 */
 
 inline
-void Column_statistics_collected::finish(ha_rows rows)
+void Column_statistics_collected::finish(ha_rows rows, double sample_fraction)
 {
   double val;
 
@@ -2538,7 +2560,7 @@ void Column_statistics_collected::finish(ha_rows rows)
     if (distincts)
     {
       val= (double) (rows - nulls) / distincts;
-      set_avg_frequency(val); 
+      set_avg_frequency(scale_sampled_avg_frequency(val, sample_fraction));
       set_not_null(COLUMN_STAT_AVG_FREQUENCY);
     }
     else
@@ -2631,7 +2653,7 @@ int collect_statistics_for_index(THD *thd, TABLE *table, uint index)
 
   if (index_prefix_calc.is_single_comp_pk)
   {
-    index_prefix_calc.get_avg_frequency();
+    index_prefix_calc.get_avg_frequency(1.0);
     DBUG_RETURN(rc);
   }
 
@@ -2661,7 +2683,8 @@ int collect_statistics_for_index(THD *thd, TABLE *table, uint index)
   rc= (rc == HA_ERR_END_OF_FILE && !thd->killed) ? 0 : 1;
 
   if (!rc)
-    index_prefix_calc.get_avg_frequency();
+    index_prefix_calc.get_avg_frequency(
+      table->file->collect_stats_sample_fraction());
 
   DBUG_RETURN(rc);
 }
@@ -2726,6 +2749,7 @@ int collect_statistics_for_table(THD *thd, TABLE *table)
   Field *table_field;
   ha_rows rows= 0;
   handler *file=table->file;
+  double sample_fraction;
 
   DBUG_ENTER("collect_statistics_for_table");
 
@@ -2776,10 +2800,12 @@ int collect_statistics_for_table(THD *thd, TABLE *table)
     and for each field f of 'table' save them in the write_stat structure
     from the Field object for f. 
   */
+  sample_fraction= file->collect_stats_sample_fraction();
   if (!rc)
   {
     table->collected_stats->cardinality_is_null= FALSE;
-    table->collected_stats->cardinality= rows;
+    table->collected_stats->cardinality= sample_fraction < 1.0 ?
+      (ha_rows) (rows / sample_fraction) : rows;
   }
 
   bitmap_clear_all(table->write_set);
@@ -2790,7 +2816,7 @@ int collect_statistics_for_table(THD *thd, TABLE *table)
       continue;
     bitmap_set_bit(table->write_set, table_field->field_index); 
     if (!rc)
-      table_field->collected_stats->finish(rows);
+      table_field->collected_stats->finish(rows, sample_fraction);
     else
       table_field->collected_stats->cleanup();
   }
@@ -6124,6 +6124,14 @@ static Sys_var_uint Sys_spider_auto_increment_mode_value(
     READ_ONLY GLOBAL_VAR(opt_spider_auto_increment_mode_value), CMD_LINE(REQUIRED_ARG),
     VALID_RANGE(0, 128), DEFAULT(1), BLOCK_SIZE(1));
 
+static Sys_var_uint Sys_spider_auto_increment_lease_size(
+    "spider_auto_increment_lease_size",
+    "the number of spider auto_increment values a table handler leases at "
+    "once, 1 means every statement reserves its values from the shared "
+    "counter",
+    GLOBAL_VAR(opt_spider_auto_increment_lease_size), CMD_LINE(REQUIRED_ARG),
+    VALID_RANGE(1, 65535), DEFAULT(1), BLOCK_SIZE(1));
+
 static Sys_var_mybool Sys_spider_ignore_single_select_index(
     "spider_ignore_single_select_index",
     "spider_ignore_single_select_index defaults is TRUE, let single select in spider ignore all index",
@@ -6203,6 +6211,11 @@ static Sys_var_mybool Sys_spider_parallel_limit(
     "spider_parallel_limit defaults is false, set spider parallel process without supporting  limit",
     GLOBAL_VAR(opt_spider_parallel_limit), CMD_LINE(OPT_ARG), DEFAULT(FALSE));
 
+static Sys_var_mybool Sys_spider_parallel_unordered_scan(
+    "spider_parallel_unordered_scan",
+    "spider_parallel_unordered_scan defaults is false, set spider to read the partitions of a parallel unordered scan in the order their results arrive",
+    GLOBAL_VAR(opt_spider_parallel_unordered_scan), CMD_LINE(OPT_ARG), DEFAULT(FALSE));
+
 static Sys_var_mybool Sys_ddl_execute_by_ctl(
     "ddl_execute_by_ctl",
     "use tdbctl to process ddl query",
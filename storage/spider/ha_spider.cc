@@ -65,6 +65,12 @@ extern SPIDER_DBTON spider_dbton[SPIDER_DBTON_SIZE];
 extern HASH spider_open_tables;
 #endif
 extern pthread_mutex_t spider_lgtm_tblhnd_share_mutex;
+extern volatile ulonglong spider_point_batches;
+extern volatile ulonglong spider_point_batch_lookups;
+extern PSI_stage_info spd_stage_point_batch;
+#ifdef HAVE_PSI_INTERFACE
+extern PSI_cond_key spd_key_cond_point_batch;
+#endif
 
 ha_spider::ha_spider() : handler(spider_hton_ptr, NULL) {
   DBUG_ENTER("ha_spider::ha_spider");
@@ -82,6 +88,10 @@ ha_spider::ha_spider() : handler(spider_hton_ptr, NULL) {
   trx_conn_adjustment = 0;
   search_link_query_id = 0;
   searched_bitmap = NULL;
+  fetch_plan = NULL;
+  fetch_plan_table = NULL;
+  fetch_plan_init = FALSE;
+  fetch_plan_all_columns = FALSE;
 #ifdef WITH_PARTITION_STORAGE_ENGINE
   partition_handler_share = NULL;
   pt_handler_share_creator = NULL;
@@ -109,6 +119,12 @@ ha_spider::ha_spider() : handler(spider_hton_ptr, NULL) {
 #endif
   use_pre_call = FALSE;
   use_pre_records = FALSE;
+  pre_call_for_mrr = FALSE;
+  config_cache = NULL;
+  config_cache_mode = SPD_CC_NONE;
+  config_cache_key = NULL;
+  config_cache_capture.init_calc_mem(239);
+  stats_sample_fraction = 1.0;
 #ifdef HANDLER_HAS_DIRECT_UPDATE_ROWS
   do_direct_update = FALSE;
   direct_update_fields = NULL;
@@ -144,6 +160,8 @@ ha_spider::ha_spider() : handler(spider_hton_ptr, NULL) {
   result_list.direct_limit_offset = FALSE;
   result_list.set_split_read = FALSE;
   result_list.insert_dup_update_pushdown = FALSE;
+  insert_pending_rows = 0;
+  insert_dup_resolved_rows = 0;
   result_list.tmp_pos_row_first = NULL;
 #ifdef HANDLER_HAS_DIRECT_AGGREGATE
   result_list.direct_aggregate = FALSE;
@@ -178,6 +196,10 @@ ha_spider::ha_spider(handlerton *hton, TABLE_SHARE *table_arg)
   trx_conn_adjustment = 0;
   search_link_query_id = 0;
   searched_bitmap = NULL;
+  fetch_plan = NULL;
+  fetch_plan_table = NULL;
+  fetch_plan_init = FALSE;
+  fetch_plan_all_columns = FALSE;
 #ifdef WITH_PARTITION_STORAGE_ENGINE
   partition_handler_share = NULL;
   pt_handler_share_creator = NULL;
@@ -205,6 +227,12 @@ ha_spider::ha_spider(handlerton *hton, TABLE_SHARE *table_arg)
 #endif
   use_pre_call = FALSE;
   use_pre_records = FALSE;
+  pre_call_for_mrr = FALSE;
+  config_cache = NULL;
+  config_cache_mode = SPD_CC_NONE;
+  config_cache_key = NULL;
+  config_cache_capture.init_calc_mem(239);
+  stats_sample_fraction = 1.0;
 #ifdef HANDLER_HAS_DIRECT_UPDATE_ROWS
   do_direct_update = FALSE;
   direct_update_fields = NULL;
@@ -239,6 +267,8 @@ ha_spider::ha_spider(handlerton *hton, TABLE_SHARE *table_arg)
   result_list.direct_limit_offset = FALSE;
   result_list.set_split_read = FALSE;
   result_list.insert_dup_update_pushdown = FALSE;
+  insert_pending_rows = 0;
+  insert_dup_resolved_rows = 0;
   result_list.tmp_pos_row_first = NULL;
 #ifdef HANDLER_HAS_DIRECT_AGGREGATE
   result_list.direct_aggregate = FALSE;
@@ -453,6 +483,11 @@ int ha_spider::open(const char *name, int mode, uint test_if_locked) {
   result_list.first = NULL;
   result_list.last = NULL;
   result_list.current = NULL;
+  result_list.bgs_stored = NULL;
+  result_list.bgs_caller_waiting = FALSE;
+  result_list.bgs_read_ahead = 1;
+  result_list.bgs_read_ahead_trx = NULL;
+  result_list.bgs_read_ahead_size = 0;
   result_list.record_num = 0;
   if (!(result_list.sqls = new spider_string[share->link_count]) ||
       !(result_list.insert_sqls = new spider_string[share->link_count]) ||
@@ -583,6 +618,11 @@ int ha_spider::close() {
   DBUG_ENTER("ha_spider::close");
   DBUG_PRINT("info", ("spider this=%p", this));
 
+  config_cache_free();
+  if (config_cache_key) {
+    spider_free(spider_current_trx, config_cache_key, MYF(0));
+    config_cache_key = NULL;
+  }
 #ifdef HA_MRR_USE_DEFAULT_IMPL
   if (multi_range_keys) {
     DBUG_PRINT("info", ("spider free multi_range_keys=%p", multi_range_keys));
@@ -658,6 +698,11 @@ int ha_spider::close() {
     spider_free(spider_current_trx, searched_bitmap, MYF(0));
     searched_bitmap = NULL;
   }
+  if (fetch_plan) {
+    spider_free(spider_current_trx, fetch_plan, MYF(0));
+    fetch_plan = NULL;
+    fetch_plan_init = FALSE;
+  }
   if (blob_buff) {
     delete[] blob_buff;
     blob_buff = NULL;
@@ -932,6 +977,11 @@ int ha_spider::external_lock(THD *thd, int lock_type) {
 
   sql_command = thd_sql_command(thd);
   if (sql_command == SQLCOM_BEGIN) sql_command = SQLCOM_UNLOCK_TABLES;
+  /* analyze table reads a sample for engine-independent statistics */
+  stats_sample_fraction =
+      sql_command == SQLCOM_ANALYZE
+          ? (double)spider_param_analyze_sample_percent(thd) / 100
+          : 1.0;
   if (sql_command == SQLCOM_UNLOCK_TABLES &&
       (error_num = spider_check_trx_and_get_conn(thd, this, FALSE))) {
     DBUG_RETURN(error_num);
@@ -943,6 +993,14 @@ int ha_spider::external_lock(THD *thd, int lock_type) {
 #ifdef HA_CAN_BULK_ACCESS
   external_lock_cnt++;
 #endif
+  /*
+    writes through this server drop the cached copy of a config table,
+    before the write for new readers and after it for captures in flight
+  */
+  if ((lock_type == F_WRLCK ||
+       (lock_type == F_UNLCK && this->lock_type >= TL_WRITE_ALLOW_WRITE)) &&
+      is_spider_config_table())
+    spider_config_cache_invalidate(share);
   if (lock_type == F_UNLCK && sql_command != SQLCOM_UNLOCK_TABLES)
     DBUG_RETURN(0);
   if (store_error_num) DBUG_RETURN(store_error_num);
@@ -1090,6 +1148,8 @@ int ha_spider::reset() {
   insert_delayed = FALSE;
   use_pre_call = FALSE;
   use_pre_records = FALSE;
+  pre_call_for_mrr = FALSE;
+  config_cache_free();
   pre_bitmap_checked = FALSE;
   bulk_insert = FALSE;
   clone_bitmap_init = FALSE;
@@ -1137,6 +1197,8 @@ int ha_spider::reset() {
 #endif
   error_mode = 0;
   total_inserted_rows = 0;
+  insert_pending_rows = 0;
+  insert_dup_resolved_rows = 0;
 
   for (roop_count = 0; roop_count < (int)share->link_count; roop_count++) {
     conns[roop_count] = NULL;
@@ -1255,6 +1317,7 @@ int ha_spider::index_init(uint idx, bool sorted) {
 #endif
   pushed_pos = NULL;
   active_index = idx;
+  config_cache_mode = SPD_CC_NONE;
   result_list.sorted = sorted;
   spider_set_result_list_param(this);
   mrr_with_cnt = FALSE;
@@ -1691,6 +1754,25 @@ int ha_spider::index_read_map(uchar *buf, const uchar *key,
     }
     DBUG_RETURN(index_next(buf));
   }
+  config_cache_mode = SPD_CC_NONE;
+  if (find_flag == HA_READ_KEY_EXACT &&
+      (table->key_info[active_index].flags & (HA_NOSAME | HA_NULL_PART_KEY)) ==
+          HA_NOSAME &&
+      keypart_map == make_prev_keypart_map(spider_user_defined_key_parts(
+                         &table->key_info[active_index])) &&
+      config_cache_usable() &&
+      (config_cache ||
+       (config_cache = spider_config_cache_get(
+            share, spider_param_config_table_cache_interval(),
+            &config_cache_version))))
+    DBUG_RETURN(config_cache_index_read(buf, key, keypart_map));
+  if (find_flag == HA_READ_KEY_EXACT &&
+      active_index == table_share->primary_key &&
+      keypart_map == make_prev_keypart_map(spider_user_defined_key_parts(
+                         &table->key_info[active_index])) &&
+      point_batch_usable() &&
+      point_batch_index_read(buf, key, keypart_map, &error_num))
+    DBUG_RETURN(error_num);
   DBUG_RETURN(index_read_map_internal(buf, key, keypart_map, find_flag));
 }
 
@@ -1960,6 +2042,13 @@ int ha_spider::index_next(uchar *buf) {
     my_error(ER_QUERY_INTERRUPTED, MYF(0));
     DBUG_RETURN(ER_QUERY_INTERRUPTED);
   }
+  if (config_cache_mode == SPD_CC_INDEX || config_cache_mode == SPD_CC_POINT) {
+    /* continue on the remote server after a lookup served without it */
+    config_cache_mode = SPD_CC_NONE;
+    DBUG_RETURN(index_read_map_internal(buf, config_cache_key,
+                                        config_cache_keypart_map,
+                                        HA_READ_AFTER_KEY));
+  }
 #ifdef HA_CAN_BULK_ACCESS
   DBUG_ASSERT(!bulk_access_started);
   if (bulk_access_executing) {
@@ -1994,6 +2083,13 @@ int ha_spider::index_prev(uchar *buf) {
     my_error(ER_QUERY_INTERRUPTED, MYF(0));
     DBUG_RETURN(ER_QUERY_INTERRUPTED);
   }
+  if (config_cache_mode == SPD_CC_INDEX || config_cache_mode == SPD_CC_POINT) {
+    /* continue on the remote server after a lookup served without it */
+    config_cache_mode = SPD_CC_NONE;
+    DBUG_RETURN(index_read_map_internal(buf, config_cache_key,
+                                        config_cache_keypart_map,
+                                        HA_READ_BEFORE_KEY));
+  }
 #ifdef HA_CAN_BULK_ACCESS
   DBUG_ASSERT(!bulk_access_started);
   if (bulk_access_executing) {
@@ -2557,6 +2653,11 @@ int ha_spider::index_next_same(uchar *buf, const uchar *key, uint keylen) {
     my_error(ER_QUERY_INTERRUPTED, MYF(0));
     DBUG_RETURN(ER_QUERY_INTERRUPTED);
   }
+  if (config_cache_mode == SPD_CC_INDEX || config_cache_mode == SPD_CC_POINT) {
+    /* the cache and point batches only serve lookups of a whole unique key */
+    table->status = STATUS_NOT_FOUND;
+    DBUG_RETURN(HA_ERR_END_OF_FILE);
+  }
 #ifdef HA_CAN_BULK_ACCESS
   DBUG_ASSERT(!bulk_access_started);
   if (bulk_access_executing) {
@@ -4051,7 +4152,9 @@ int ha_spider::read_multi_range_first_internal(uchar *buf,
 int ha_spider::pre_multi_range_read_next(bool use_parallel) {
   DBUG_ENTER("ha_spider::pre_multi_range_read_next");
   DBUG_PRINT("info", ("spider this=%p", this));
+  pre_call_for_mrr = TRUE;
   check_pre_call(use_parallel);
+  pre_call_for_mrr = FALSE;
   if (use_pre_call) {
     store_error_num = multi_range_read_next_first(NULL);
     DBUG_RETURN(store_error_num);
@@ -4172,10 +4275,6 @@ int ha_spider::read_multi_range_next(KEY_MULTI_RANGE **found_range_p)
       DBUG_RETURN(0);
     }
 
-    if (error_num == HA_ERR_END_OF_FILE) {
-      DBUG_RETURN(error_num);
-    }
-
 #ifdef HA_MRR_USE_DEFAULT_IMPL
     range_res = mrr_funcs.next(mrr_iter, &mrr_cur_range);
     DBUG_PRINT("info", ("spider range_res1=%d", range_res));
@@ -5186,6 +5285,18 @@ int ha_spider::rnd_init(bool scan) {
       check_and_start_bulk_update(SPD_BU_START_BY_INDEX_OR_RND_INIT);
   */
   rnd_scan_and_first = scan;
+  config_cache_mode = SPD_CC_NONE;
+  if (scan && config_cache_usable()) {
+    if (config_cache ||
+        (config_cache = spider_config_cache_get(
+             share, spider_param_config_table_cache_interval(),
+             &config_cache_version))) {
+      /* serve the whole scan from the cached copy */
+      config_cache_mode = SPD_CC_RND;
+      config_cache_pos = 0;
+      DBUG_RETURN(0);
+    }
+  }
   if (scan && sql_command != SQLCOM_ALTER_TABLE) {
     spider_set_result_list_param(this);
     pk_update = FALSE;
@@ -5247,7 +5358,20 @@ int ha_spider::rnd_init(bool scan) {
           memset(searched_bitmap, 0xFF, no_bytes_in_map(table->read_set));
       }
 
+      if (!condition && !config_cache && config_cache_usable()) {
+        st_select_lex *select_lex = spider_get_select_lex(this);
+        if (!select_lex || !select_lex->explicit_limit) {
+          /*
+            fetch every column so that this scan can fill the cache, the
+            read_set of the statement is left alone
+          */
+          config_cache_mode = SPD_CC_CAPTURE;
+          config_cache_capture.length(0);
+        }
+      }
+
       set_select_column_mode();
+      if (config_cache_mode == SPD_CC_CAPTURE) select_column_mode = 0;
       result_list.keyread = FALSE;
 
       init_rnd_handler = FALSE;
@@ -5323,6 +5447,7 @@ int ha_spider::rnd_next_internal(uchar *buf) {
 #ifdef WITH_PARTITION_STORAGE_ENGINE
     check_select_column(TRUE);
 #endif
+    if (config_cache_mode == SPD_CC_CAPTURE) select_column_mode = 0;
 
     if (this->result_list.direct_limit_offset) {
       if (direct_limit_offset_spider->direct_select_limit ==
@@ -5558,6 +5683,7 @@ int ha_spider::rnd_next_internal(uchar *buf) {
 int ha_spider::pre_rnd_next(bool use_parallel) {
   DBUG_ENTER("ha_spider::pre_rnd_next");
   DBUG_PRINT("info", ("spider this=%p", this));
+  if (config_cache_mode == SPD_CC_RND) DBUG_RETURN(0);
   check_pre_call(use_parallel);
   if (use_pre_call) {
     store_error_num = rnd_next_internal(NULL);
@@ -5566,21 +5692,51 @@ int ha_spider::pre_rnd_next(bool use_parallel) {
   DBUG_RETURN(0);
 }
 
+/*
+  The next row is ready unless the background search of this handler is
+  still fetching the batch it needs. The background thread holds
+  bg_conn_mutex while it works, so a busy mutex means it is not done yet.
+*/
+bool ha_spider::pre_scan_ready() {
+  SPIDER_CONN *conn;
+  bool bgs_working;
+  DBUG_ENTER("ha_spider::pre_scan_ready");
+  DBUG_PRINT("info", ("spider this=%p", this));
+  if (result_list.bgs_phase == 0) DBUG_RETURN(TRUE);
+  if (use_pre_call) {
+    if (store_error_num) DBUG_RETURN(TRUE);
+  } else if (!result_list.current ||
+             result_list.current_row_num < result_list.current->record_num ||
+             result_list.current->finish_flg)
+    DBUG_RETURN(TRUE);
+  if (!(conn = conns[search_link_idx])) DBUG_RETURN(TRUE);
+  if (pthread_mutex_trylock(&conn->bg_conn_mutex)) DBUG_RETURN(FALSE);
+  bgs_working = result_list.bgs_working;
+  pthread_mutex_unlock(&conn->bg_conn_mutex);
+  DBUG_RETURN(!bgs_working);
+}
+
 int ha_spider::rnd_next(uchar *buf) {
   int error_num;
   DBUG_ENTER("ha_spider::rnd_next");
   DBUG_PRINT("info", ("spider this=%p", this));
+  if (config_cache_mode == SPD_CC_RND) DBUG_RETURN(config_cache_rnd_next(buf));
   if (use_pre_call) {
     if (store_error_num) {
       if (store_error_num == HA_ERR_END_OF_FILE)
         table->status = STATUS_NOT_FOUND;
+      if (config_cache_mode == SPD_CC_CAPTURE)
+        config_cache_capture_row(buf, store_error_num);
       DBUG_RETURN(store_error_num);
     }
     if ((error_num = spider_bg_all_conn_pre_next(this, search_link_idx)))
       DBUG_RETURN(error_num);
     use_pre_call = FALSE;
   }
-  DBUG_RETURN(rnd_next_internal(buf));
+  error_num = rnd_next_internal(buf);
+  if (config_cache_mode == SPD_CC_CAPTURE)
+    config_cache_capture_row(buf, error_num);
+  DBUG_RETURN(error_num);
 }
 
 void ha_spider::position(const uchar *record) {
@@ -5591,6 +5747,19 @@ void ha_spider::position(const uchar *record) {
     memcpy(ref, pushed_pos, ref_length);
     DBUG_VOID_RETURN;
   }
+  if (config_cache_mode == SPD_CC_RND || config_cache_mode == SPD_CC_INDEX) {
+    memset(ref, 0, sizeof(SPIDER_POSITION));
+    ((SPIDER_POSITION *)ref)->config_cache_row = config_cache_row;
+    DBUG_VOID_RETURN;
+  }
+  if (config_cache_mode == SPD_CC_POINT) {
+    /* the row of a point batch is kept until the end of the statement */
+    uchar *row = (uchar *)thd_alloc(ha_thd(), table_share->reclength);
+    if (row) memcpy(row, record, table_share->reclength);
+    memset(ref, 0, sizeof(SPIDER_POSITION));
+    ((SPIDER_POSITION *)ref)->config_cache_row = row;
+    DBUG_VOID_RETURN;
+  }
   if (pt_clone_last_searcher) {
     /* sercher is cloned handler */
     DBUG_PRINT("info", ("spider cloned handler access"));
@@ -5638,9 +5807,491 @@ int ha_spider::rnd_pos(uchar *buf, uchar *pos) {
   DBUG_PRINT("info", ("spider buf=%p", buf));
   pushed_pos_buf = *((SPIDER_POSITION *)pos);
   pushed_pos = &pushed_pos_buf;
+  if (pushed_pos_buf.config_cache_row) {
+    memcpy(buf, pushed_pos_buf.config_cache_row, table_share->reclength);
+    DBUG_RETURN(0);
+  }
   DBUG_RETURN(spider_db_seek_tmp(buf, &pushed_pos_buf, this, table));
 }
 
+bool ha_spider::config_cache_usable() {
+  THD *thd = ha_thd();
+  DBUG_ENTER("ha_spider::config_cache_usable");
+  DBUG_PRINT("info", ("spider this=%p", this));
+  if (!spider_param_config_table_cache_interval() ||
+      !is_spider_config_table() || sql_command != SQLCOM_SELECT ||
+      lock_type != TL_READ || spider_conn_lock_mode(this) ||
+      thd->locked_tables_mode ||
+      thd_test_options(thd, OPTION_NOT_AUTOCOMMIT | OPTION_BEGIN) ||
+      table_share->blob_fields || table->vfield || is_clone ||
+      spider_param_error_read_mode(thd, share->error_read_mode))
+    DBUG_RETURN(FALSE);
+  DBUG_RETURN(TRUE);
+}
+
+void ha_spider::config_cache_free() {
+  DBUG_ENTER("ha_spider::config_cache_free");
+  DBUG_PRINT("info", ("spider this=%p", this));
+  config_cache_mode = SPD_CC_NONE;
+  if (config_cache) {
+    spider_config_cache_release(share, config_cache);
+    config_cache = NULL;
+  }
+  if (config_cache_capture.is_alloced()) config_cache_capture.free();
+  DBUG_VOID_RETURN;
+}
+
+/*
+  Check a cached row against the key of an index lookup and the pushed
+  conditions. The fields are moved onto the row while they are evaluated.
+*/
+bool ha_spider::config_cache_match(const uchar *row, const uchar *key,
+                                   uint key_len) {
+  bool match = TRUE;
+  SPIDER_CONDITION *tmp_cond;
+  DBUG_ENTER("ha_spider::config_cache_match");
+  table->move_fields(table->field, row, table->record[0]);
+  if (key) match = !key_cmp(table->key_info[active_index].key_part, key, key_len);
+  for (tmp_cond = condition; match && tmp_cond; tmp_cond = tmp_cond->next)
+    match = tmp_cond->cond->val_int() != 0;
+  table->move_fields(table->field, table->record[0], row);
+  DBUG_RETURN(match);
+}
+
+int ha_spider::config_cache_rnd_next(uchar *buf) {
+  uint reclength = config_cache->reclength;
+  DBUG_ENTER("ha_spider::config_cache_rnd_next");
+  DBUG_PRINT("info", ("spider this=%p", this));
+  if (trx->thd->killed) {
+    my_error(ER_QUERY_INTERRUPTED, MYF(0));
+    DBUG_RETURN(ER_QUERY_INTERRUPTED);
+  }
+  while (config_cache_pos < config_cache->records) {
+    config_cache_row = config_cache->rows + config_cache_pos * reclength;
+    config_cache_pos++;
+    if (config_cache_match(config_cache_row, NULL, 0)) {
+      memcpy(buf, config_cache_row, reclength);
+      DBUG_RETURN(0);
+    }
+  }
+  table->status = STATUS_NOT_FOUND;
+  DBUG_RETURN(HA_ERR_END_OF_FILE);
+}
+
+/*
+  Serve an exact lookup of a whole unique key from the cached copy. The key
+  is kept so that a following index_next or index_prev can continue on the
+  remote server.
+*/
+int ha_spider::config_cache_index_read(uchar *buf, const uchar *key,
+                                       key_part_map keypart_map) {
+  uint key_len = calculate_key_len(table, active_index, key, keypart_map);
+  uint reclength = config_cache->reclength;
+  ha_rows first = 0, last = config_cache->records, middle;
+  uchar **key_rows = config_cache->key_rows + active_index * last;
+  int cmp;
+  DBUG_ENTER("ha_spider::config_cache_index_read");
+  DBUG_PRINT("info", ("spider this=%p", this));
+  if (trx->thd->killed) {
+    my_error(ER_QUERY_INTERRUPTED, MYF(0));
+    DBUG_RETURN(ER_QUERY_INTERRUPTED);
+  }
+  if (!config_cache_key &&
+      !(config_cache_key = (uchar *)spider_malloc(
+            spider_current_trx, 234, table_share->max_key_length, MYF(MY_WME))))
+    DBUG_RETURN(HA_ERR_OUT_OF_MEM);
+  memcpy(config_cache_key, key, key_len);
+  config_cache_keypart_map = keypart_map;
+  config_cache_mode = SPD_CC_INDEX;
+  /* the rows are sorted by this unique key, search the first not below */
+  while (first < last) {
+    middle = first + (last - first) / 2;
+    table->move_fields(table->field, key_rows[middle], table->record[0]);
+    cmp = key_cmp(table->key_info[active_index].key_part, key, key_len);
+    table->move_fields(table->field, table->record[0], key_rows[middle]);
+    if (cmp < 0)
+      first = middle + 1;
+    else
+      last = middle;
+  }
+  if (first < config_cache->records &&
+      config_cache_match(key_rows[first], key, key_len)) {
+    config_cache_row = key_rows[first];
+    memcpy(buf, config_cache_row, reclength);
+    DBUG_RETURN(0);
+  }
+  table->status = STATUS_NOT_FOUND;
+  DBUG_RETURN(HA_ERR_KEY_NOT_FOUND);
+}
+
+void ha_spider::config_cache_capture_row(const uchar *buf, int error_num) {
+  DBUG_ENTER("ha_spider::config_cache_capture_row");
+  DBUG_PRINT("info", ("spider this=%p", this));
+  if (!error_num) {
+    if (config_cache_capture.length() + table_share->reclength >
+            SPIDER_CONFIG_CACHE_MAX_SIZE ||
+        config_cache_capture.append((const char *)buf,
+                                    table_share->reclength))
+      config_cache_mode = SPD_CC_NONE;
+    DBUG_VOID_RETURN;
+  }
+  config_cache_mode = SPD_CC_NONE;
+  if (error_num != HA_ERR_END_OF_FILE ||
+#ifdef HANDLER_HAS_DIRECT_AGGREGATE
+      result_list.direct_aggregate ||
+#endif
+#ifdef INFO_KIND_FORCE_LIMIT_BEGIN
+      info_limit < 9223372036854775807LL ||
+#endif
+      result_list.direct_order_limit || result_list.direct_limit_offset ||
+      result_list.direct_distinct)
+    DBUG_VOID_RETURN;
+  spider_config_cache_publish(
+      share, table, config_cache_version,
+      (const uchar *)config_cache_capture.ptr(),
+      config_cache_capture.length() / table_share->reclength);
+  DBUG_VOID_RETURN;
+}
+
+bool ha_spider::point_batch_usable() {
+  THD *thd = ha_thd();
+  KEY *key_info = &table->key_info[active_index];
+  uint roop_count;
+  DBUG_ENTER("ha_spider::point_batch_usable");
+  DBUG_PRINT("info", ("spider this=%p", this));
+  if (!spider_param_point_batch_window(thd) || sql_command != SQLCOM_SELECT ||
+      lock_type != TL_READ || spider_conn_lock_mode(this) ||
+      thd->locked_tables_mode ||
+      thd_test_options(thd, OPTION_NOT_AUTOCOMMIT | OPTION_BEGIN) ||
+      table_share->blob_fields || table->vfield || is_clone || ft_count ||
+      spider_param_error_read_mode(thd, share->error_read_mode))
+    DBUG_RETURN(FALSE);
+  check_direct_order_limit();
+  if (
+#ifdef HANDLER_HAS_DIRECT_AGGREGATE
+      result_list.direct_aggregate ||
+#endif
+      result_list.direct_order_limit || result_list.direct_limit_offset ||
+      result_list.direct_distinct)
+    DBUG_RETURN(FALSE);
+  /* the rows of a batch are told apart by their primary key */
+  for (roop_count = 0; roop_count < spider_user_defined_key_parts(key_info);
+       roop_count++) {
+    if (!bitmap_is_set(table->read_set,
+                       key_info->key_part[roop_count].field->field_index))
+      DBUG_RETURN(FALSE);
+  }
+  DBUG_RETURN(TRUE);
+}
+
+/*
+  Take a lookup out of a point batch its session stopped waiting for, the
+  first session does not touch it any more. Called under share->mutex.
+*/
+static void spider_point_batch_unlink(SPIDER_POINT_BATCH *batch,
+                                      SPIDER_POINT_REQ *req) {
+  SPIDER_POINT_REQ *prev = batch->first;
+  DBUG_ENTER("spider_point_batch_unlink");
+  while (prev->next != req) prev = prev->next;
+  prev->next = req->next;
+  if (batch->last == req) batch->last = prev;
+  batch->req_count--;
+  DBUG_VOID_RETURN;
+}
+
+/*
+  Gather the primary key lookups of concurrent autocommit reads of this share
+  and link. When other sessions are looking up the share, the first session
+  waits up to point_batch_window microseconds for them, sends all keys as one
+  query and hands every session its row. A lookup without company is sent at
+  once. The sessions of a batch read the same columns, so the row is copied
+  as a whole record. Returns FALSE when the lookup has not been done.
+*/
+bool ha_spider::point_batch_index_read(uchar *buf, const uchar *key,
+                                       key_part_map keypart_map,
+                                       int *error_num) {
+  THD *thd = trx->thd;
+  uint key_len = calculate_key_len(table, active_index, key, keypart_map);
+  uint link_idx;
+  int error;
+  bool sent;
+  struct timespec abstime;
+  PSI_stage_info old_stage;
+  SPIDER_POINT_REQ req;
+  SPIDER_POINT_BATCH leader_batch, *batch;
+  DBUG_ENTER("ha_spider::point_batch_index_read");
+  DBUG_PRINT("info", ("spider this=%p", this));
+  if (thd->killed) {
+    my_error(ER_QUERY_INTERRUPTED, MYF(0));
+    *error_num = ER_QUERY_INTERRUPTED;
+    DBUG_RETURN(TRUE);
+  }
+  if ((*error_num = index_handler_init())) {
+    *error_num = check_error_mode_eof(*error_num);
+    DBUG_RETURN(TRUE);
+  }
+  if ((*error_num = spider_set_conn_bg_param(this))) DBUG_RETURN(TRUE);
+  if (sql_kinds != SPIDER_SQL_KIND_SQL || result_list.bgs_phase > 0)
+    DBUG_RETURN(FALSE);
+  link_idx = conn_link_idx[search_link_idx];
+  req.key = key;
+  req.buf = buf;
+  req.found = FALSE;
+  req.next = NULL;
+
+  my_atomic_add32(&share->point_lookups, 1);
+  pthread_mutex_lock(&share->mutex);
+  if ((batch = share->point_batch)) {
+    if (batch->table_share != table_share || batch->link_idx != link_idx ||
+        batch->key_length != key_len ||
+        !bitmap_cmp(batch->read_set, table->read_set) ||
+        !bitmap_cmp(batch->write_set, table->write_set)) {
+      pthread_mutex_unlock(&share->mutex);
+      goto send_alone;
+    }
+    batch->last->next = &req;
+    batch->last = &req;
+    batch->waiting++;
+    if (++batch->req_count >= SPIDER_POINT_BATCH_MAX_KEYS) {
+      /* full, let the first session send it now */
+      share->point_batch = NULL;
+      pthread_cond_broadcast(&batch->cond);
+    }
+    /* the first session sends within the window and the read timeout */
+    set_timespec_nsec(
+        abstime,
+        spider_param_point_batch_window(thd) * 1000ULL +
+            spider_param_net_read_timeout(
+                thd, share->net_read_timeouts[search_link_idx]) *
+                1000000000ULL);
+    THD_ENTER_COND(thd, &batch->cond, &share->mutex, &spd_stage_point_batch,
+                   &old_stage);
+    thd_wait_begin(thd, THD_WAIT_NET);
+    while (!batch->done && !thd_killed(thd)) {
+      error = pthread_cond_timedwait(&batch->cond, &share->mutex, &abstime);
+      if (error == ETIMEDOUT || error == ETIME) break;
+    }
+    thd_wait_end(thd);
+    if (batch->done)
+      error = batch->error_num;
+    else {
+      spider_point_batch_unlink(batch, &req);
+      error = thd_killed(thd) ? ER_QUERY_INTERRUPTED : ETIMEDOUT;
+    }
+    if (!--batch->waiting) pthread_cond_broadcast(&batch->cond);
+    THD_EXIT_COND(thd, &old_stage);
+    if (error == ER_QUERY_INTERRUPTED) {
+      my_error(ER_QUERY_INTERRUPTED, MYF(0));
+      *error_num = ER_QUERY_INTERRUPTED;
+      goto end;
+    }
+    /* the lookup is sent on its own when the batch failed */
+    if (error) goto send_alone;
+  } else if (my_atomic_load32(&share->point_lookups) > 1) {
+    batch = &leader_batch;
+    mysql_cond_init(spd_key_cond_point_batch, &batch->cond, NULL);
+    batch->table_share = table_share;
+    batch->link_idx = link_idx;
+    batch->key_length = key_len;
+    batch->read_set = table->read_set;
+    batch->write_set = table->write_set;
+    batch->first = &req;
+    batch->last = &req;
+    batch->req_count = 1;
+    batch->waiting = 0;
+    batch->done = FALSE;
+    batch->error_num = 0;
+    share->point_batch = batch;
+    set_timespec_nsec(abstime,
+                      spider_param_point_batch_window(thd) * 1000ULL);
+    thd_wait_begin(thd, THD_WAIT_SLEEP);
+    while (share->point_batch == batch && !thd->killed) {
+      error = pthread_cond_timedwait(&batch->cond, &share->mutex, &abstime);
+      if (error == ETIMEDOUT || error == ETIME) break;
+    }
+    thd_wait_end(thd);
+    if (share->point_batch == batch) share->point_batch = NULL;
+    sent = batch->req_count > 1;
+    pthread_mutex_unlock(&share->mutex);
+
+    /* nobody can join any more, but the others may still leave */
+    if (sent) *error_num = point_batch_query(batch);
+
+    pthread_mutex_lock(&share->mutex);
+    if (sent) {
+      spider_point_batches++;
+      spider_point_batch_lookups += batch->req_count;
+    }
+    batch->error_num = *error_num;
+    batch->done = TRUE;
+    pthread_cond_broadcast(&batch->cond);
+    while (batch->waiting) pthread_cond_wait(&batch->cond, &share->mutex);
+    pthread_mutex_unlock(&share->mutex);
+    pthread_cond_destroy(&batch->cond);
+    if (!sent) goto send_alone;
+    if (*error_num) {
+      *error_num = check_error_mode_eof(*error_num);
+      goto end;
+    }
+  } else {
+    /* nobody else is looking up this share, do not wait for company */
+    pthread_mutex_unlock(&share->mutex);
+    goto send_alone;
+  }
+
+  /* keep the key, index_next and index_prev continue on the remote server */
+  if (!config_cache_key &&
+      !(config_cache_key = (uchar *)spider_malloc(
+            spider_current_trx, 234, table_share->max_key_length, MYF(MY_WME)))) {
+    *error_num = HA_ERR_OUT_OF_MEM;
+    goto end;
+  }
+  memcpy(config_cache_key, key, key_len);
+  config_cache_keypart_map = keypart_map;
+  config_cache_mode = SPD_CC_POINT;
+  if (req.found && config_cache_match(buf, NULL, 0)) {
+    table->status = 0;
+    *error_num = 0;
+  } else {
+    table->status = STATUS_NOT_FOUND;
+    *error_num = HA_ERR_KEY_NOT_FOUND;
+  }
+  goto end;
+
+send_alone:
+  *error_num =
+      index_read_map_internal(buf, key, keypart_map, HA_READ_KEY_EXACT);
+end:
+  my_atomic_add32(&share->point_lookups, -1);
+  DBUG_RETURN(TRUE);
+}
+
+/*
+  Send the keys of a point batch as one query on the connection of this
+  handler and copy every row found into the record of the session that
+  asked for its key.
+*/
+int ha_spider::point_batch_query(SPIDER_POINT_BATCH *batch) {
+  int error_num, tmp_select_column_mode = select_column_mode;
+  ulong sql_type = SPIDER_SQL_TYPE_SELECT_SQL;
+  SPIDER_CONN *conn;
+  SPIDER_POINT_REQ *req;
+  spider_db_handler *dbton_hdl;
+  bool own_row = FALSE;
+  DBUG_ENTER("ha_spider::point_batch_query");
+  DBUG_PRINT("info", ("spider this=%p", this));
+  DBUG_PRINT("info", ("spider req_count=%u", batch->req_count));
+  spider_db_free_one_result_for_start_next(this);
+  spider_set_result_list_param(this);
+  if ((error_num = reset_sql_sql(SPIDER_SQL_TYPE_SELECT_SQL)))
+    DBUG_RETURN(error_num);
+#ifdef WITH_PARTITION_STORAGE_ENGINE
+  check_select_column(FALSE);
+#endif
+  result_list.finish_flg = FALSE;
+  result_list.record_num = 0;
+  /* every session of the batch takes its columns from the same row */
+  result_list.keyread = FALSE;
+  select_column_mode = 0;
+  if ((error_num = spider_db_append_select(this)) ||
+      (error_num = spider_db_append_select_columns(this)))
+    goto end;
+  if (share->key_hint &&
+      (error_num = append_hint_after_table_sql_part(sql_type)))
+    goto end;
+  set_where_pos_sql(sql_type);
+  result_list.desc_flg = FALSE;
+  result_list.sorted = FALSE;
+  result_list.key_info = &table->key_info[active_index];
+  /* sessions giving up leave the batch under the share mutex */
+  pthread_mutex_lock(&share->mutex);
+  result_list.limit_num = batch->req_count;
+  error_num = append_point_keys_where_sql_part(batch->first, sql_type);
+  pthread_mutex_unlock(&share->mutex);
+  if (error_num ||
+      (error_num = append_limit_sql_part(0, result_list.limit_num, sql_type)))
+    goto end;
+
+  if (!(conn = spider_get_conn_by_idx(search_link_idx))) {
+    error_num = ER_SPIDER_CON_COUNT_ERROR;
+    goto end;
+  }
+  dbton_hdl = dbton_handler[conn->dbton_id];
+  if (dbton_hdl->need_lock_before_set_sql_for_exec(sql_type))
+    spider_mta_conn_mutex_lock(conn);
+  if ((error_num = dbton_hdl->set_sql_for_exec(sql_type, search_link_idx)))
+    goto end;
+  if (!dbton_hdl->need_lock_before_set_sql_for_exec(sql_type))
+    spider_mta_conn_mutex_lock(conn);
+  conn->need_mon = &need_mons[search_link_idx];
+  conn->mta_conn_mutex_lock_already = TRUE;
+  conn->mta_conn_mutex_unlock_later = TRUE;
+  if ((error_num = spider_db_set_names(this, conn, search_link_idx))) {
+    conn->mta_conn_mutex_lock_already = FALSE;
+    conn->mta_conn_mutex_unlock_later = FALSE;
+    spider_mta_conn_mutex_unlock(conn);
+    goto error_mon;
+  }
+  spider_conn_set_timeout_from_share(conn, search_link_idx, trx->thd, share);
+  if (dbton_hdl->execute_sql(sql_type, conn, result_list.quick_mode,
+                             &need_mons[search_link_idx])) {
+    conn->mta_conn_mutex_lock_already = FALSE;
+    conn->mta_conn_mutex_unlock_later = FALSE;
+    error_num = spider_db_errorno(conn);
+    goto error_mon;
+  }
+  connection_ids[search_link_idx] = conn->connection_id;
+  conn->mta_conn_mutex_lock_already = FALSE;
+  conn->mta_conn_mutex_unlock_later = FALSE;
+  if ((error_num = spider_db_store_result(this, search_link_idx, table))) {
+    if (error_num == HA_ERR_END_OF_FILE) {
+      /* none of the keys exists */
+      error_num = 0;
+      goto end;
+    }
+    goto error_mon;
+  }
+  result_link_idx = search_link_idx;
+  while (result_list.current_row_num < result_list.current->record_num) {
+    if ((error_num = spider_db_fetch(table->record[0], this, table))) {
+      if (error_num == HA_ERR_END_OF_FILE) error_num = 0;
+      goto end;
+    }
+    pthread_mutex_lock(&share->mutex);
+    for (req = batch->first; req; req = req->next) {
+      if (!req->found && !key_cmp(result_list.key_info->key_part, req->key,
+                                  batch->key_length)) {
+        /* the next fetch overwrites record[0], keep our own row aside */
+        if (req->buf != table->record[0])
+          memcpy(req->buf, table->record[0], table_share->reclength);
+        else {
+          memcpy(table->record[1], table->record[0], table_share->reclength);
+          own_row = TRUE;
+        }
+        req->found = TRUE;
+      }
+    }
+    pthread_mutex_unlock(&share->mutex);
+  }
+  goto end;
+
+error_mon:
+  if (share->monitoring_kind[search_link_idx] && need_mons[search_link_idx]) {
+    error_num = spider_ping_table_mon_from_table(
+        trx, trx->thd, share, search_link_idx,
+        (uint32)share->monitoring_sid[search_link_idx], share->table_name,
+        share->table_name_length, conn_link_idx[search_link_idx], NULL, 0,
+        share->monitoring_kind[search_link_idx],
+        share->monitoring_limit[search_link_idx],
+        share->monitoring_flag[search_link_idx], TRUE);
+  }
+end:
+  if (own_row)
+    memcpy(table->record[0], table->record[1], table_share->reclength);
+  select_column_mode = tmp_select_column_mode;
+  DBUG_RETURN(error_num);
+}
+
 int ha_spider::cmp_ref(const uchar *ref1, const uchar *ref2) {
   int ret = 0;
   DBUG_ENTER("ha_spider::cmp_ref");
@@ -6087,6 +6738,7 @@ int ha_spider::info(uint flag) {
 
     /* get table table status from tb_spider_table_status */
     if (spider_param_get_sts_or_crd()) {
+      share->status_access_count++;
       spider_get_table_status_for_share(share);
     }
     if (flag & HA_STATUS_CONST) {
@@ -6190,7 +6842,6 @@ ha_rows ha_spider::records_in_range(uint inx, key_range *start_key,
         }
       }
       pthread_mutex_unlock(&share->crd_mutex);
-      if (crd_mode == 3) crd_mode = 1;
       crd_interval = 0;
     }
   }
@@ -6304,9 +6955,35 @@ ha_rows ha_spider::records_in_range(uint inx, key_range *start_key,
     DBUG_PRINT("info", ("spider rows4=%f", rows));
     DBUG_RETURN((ha_rows)rows);
   } else if (crd_mode == 3) {
+    uint cache_interval = spider_param_crd_explain_cache_interval();
+    ha_checksum range_hash = 0;
+    ha_rows rows;
+    if (cache_interval) {
+      range_hash = spider_range_estimate_hash(inx, start_key, end_key);
+      if ((rows = spider_get_range_estimate(share, inx, start_key, end_key,
+                                            range_hash, cache_interval)) !=
+          HA_POS_ERROR)
+        DBUG_RETURN(rows);
+    }
+    /*
+      the optimizer passes an inclusive lower bound as HA_READ_KEY_EXACT,
+      the key where builder takes it as equality
+    */
+    key_range explain_start_key, *explain_start_key_ptr = start_key;
+    if (start_key && end_key && start_key->flag == HA_READ_KEY_EXACT) {
+      explain_start_key = *start_key;
+      explain_start_key.flag = HA_READ_KEY_OR_NEXT;
+      explain_start_key_ptr = &explain_start_key;
+    }
     result_list.key_info = &table->key_info[inx];
-    DBUG_RETURN(
-        spider_db_explain_select(start_key, end_key, this, search_link_idx));
+    rows = spider_db_explain_select(explain_start_key_ptr, end_key, this,
+                                    search_link_idx);
+    /* the optimizer takes 0 as an empty range */
+    if (rows == 0) rows = 1;
+    if (cache_interval && rows != HA_POS_ERROR)
+      spider_set_range_estimate(share, inx, start_key, end_key, range_hash,
+                                rows);
+    DBUG_RETURN(rows);
   }
   DBUG_RETURN((ha_rows)spider_param_crd_weight(thd, share->crd_weight));
 }
@@ -6879,6 +7556,15 @@ int ha_spider::write_row(uchar *buf) {
   backup_error_status();
   DBUG_ENTER("ha_spider::write_row");
   DBUG_PRINT("info", ("spider this=%p", this));
+#ifdef HANDLER_HAS_DIRECT_UPDATE_ROWS
+  /*
+    A pushed down "on duplicate key update" resolves duplicates on the
+    remote server, so the rows can be sent in one multi-row statement
+    just like "replace".
+  */
+  if (result_list.insert_dup_update_pushdown) skip_insert_ingore = TRUE;
+#endif
+  if (write_can_replace) skip_insert_ingore = TRUE;
   if (spider_param_read_only_mode(thd, share->read_only_mode)) {
     my_printf_error(ER_SPIDER_READ_ONLY_NUM, ER_SPIDER_READ_ONLY_STR, MYF(0),
                     table_share->db.str, table_share->table_name.str);
@@ -8693,6 +9379,17 @@ void ha_spider::cond_pop() {
   DBUG_VOID_RETURN;
 }
 
+longlong ha_spider::dup_resolved_rows() {
+  SPIDER_CONN *conn = spider_get_conn_by_idx(0);
+  DBUG_ENTER("ha_spider::dup_resolved_rows");
+  DBUG_PRINT("info", ("spider this=%p", this));
+  /* bg inserts count their affected rows when they finish */
+  if (conn && conn->bg_conn_working) spider_bg_all_conn_break(this);
+  DBUG_PRINT("info", ("spider insert_dup_resolved_rows=%lld",
+                      insert_dup_resolved_rows));
+  DBUG_RETURN(insert_dup_resolved_rows);
+}
+
 int ha_spider::info_push(uint info_type, void *info) {
   int error_num = 0;
   DBUG_ENTER("ha_spider::info_push");
@@ -9472,6 +10169,7 @@ int ha_spider::index_handler_init() {
   int roop_start, roop_end, roop_count;
   DBUG_ENTER("ha_spider::index_handler_init");
   DBUG_PRINT("info", ("spider this=%p", this));
+  config_cache_mode = SPD_CC_NONE;
   if (!init_index_handler) {
     init_index_handler = TRUE;
     lock_mode = spider_conn_lock_mode(this);
@@ -9752,7 +10450,8 @@ void ha_spider::check_pre_call(bool use_parallel) {
   if ((thd_test_options(thd, OPTION_NOT_AUTOCOMMIT) ||
        thd_test_options(thd, OPTION_BEGIN)) ||
       thd->sql_use_partition_count < 2 || is_spider_select_limit_x_y(this) ||
-      is_spider_select_mul_table(this) ||
+      (is_spider_select_mul_table(this) &&
+       !(pre_call_for_mrr && spider_param_bka_parallel_search(thd))) ||
       thd->lex->spider_rone_shard_flag) /* use option spider_rone_shard,  choose only one remote shard by random */
   {
     use_pre_call = FALSE;
@@ -10454,6 +11153,23 @@ int ha_spider::append_key_where_sql_part(const key_range *start_key,
   DBUG_RETURN(0);
 }
 
+int ha_spider::append_point_keys_where_sql_part(SPIDER_POINT_REQ *first,
+                                                ulong sql_type) {
+  int error_num;
+  uint roop_count, dbton_id;
+  spider_db_handler *dbton_hdl;
+  DBUG_ENTER("ha_spider::append_point_keys_where_sql_part");
+  for (roop_count = 0; roop_count < share->use_sql_dbton_count; roop_count++) {
+    dbton_id = share->use_sql_dbton_ids[roop_count];
+    dbton_hdl = dbton_handler[dbton_id];
+    if (dbton_hdl->first_link_idx >= 0 &&
+        (error_num = dbton_hdl->append_point_keys_where_part(first, sql_type))) {
+      DBUG_RETURN(error_num);
+    }
+  }
+  DBUG_RETURN(0);
+}
+
 int ha_spider::append_match_where_sql_part(ulong sql_type) {
   int error_num;
   uint roop_count, dbton_id;
@@ -11359,7 +12075,8 @@ SPIDER_CONN *ha_spider::spider_get_conn_by_idx(int link_idx) {
 int ha_spider::spider_set_trx_status_info() {
   int error_num, roop_count;
   THD *thd = current_thd;
-  bool sync_trx_isolation = spider_param_sync_trx_isolation(thd);
+  bool sync_trx_isolation =
+      spider_param_sync_trx_isolation(thd) || spider_conn_multiplexed(thd);
   DBUG_ENTER("ha_spider::spider_set_trx_status_info");
 
   if (!conns[search_link_idx]) {
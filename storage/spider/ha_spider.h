@@ -80,6 +80,15 @@ class ha_spider : public handler {
   spider_string *blob_buff;
   uchar *searched_bitmap;
   uchar *ft_discard_bitmap;
+  /* columns fetched for the read_set/write_set copies below */
+  SPIDER_FETCH_PLAN_COLUMN *fetch_plan;
+  TABLE *fetch_plan_table;
+  uint fetch_plan_count;
+  uint fetch_plan_tail_skip;
+  bool fetch_plan_init;
+  bool fetch_plan_all_columns;
+  uchar *fetch_plan_read_bitmap;
+  uchar *fetch_plan_write_bitmap;
   bool position_bitmap_init;
   uchar *position_bitmap;
   SPIDER_POSITION *pushed_pos;
@@ -158,7 +167,22 @@ class ha_spider : public handler {
   bool insert_delayed;
   bool use_pre_call;
   bool use_pre_records;
+  bool pre_call_for_mrr;
   bool pre_bitmap_checked;
+
+  /* for config table cache */
+  SPIDER_CONFIG_CACHE *config_cache;
+  spider_config_cache_mode config_cache_mode;
+  ha_rows config_cache_pos;
+  uchar *config_cache_row;
+  uchar *config_cache_key;
+  key_part_map config_cache_keypart_map;
+  ulonglong config_cache_version;
+  spider_string config_cache_capture;
+
+  /* for analyze table */
+  double stats_sample_fraction;
+
   enum thr_lock_type lock_type;
   int lock_mode;
   uint sql_command;
@@ -173,6 +197,13 @@ class ha_spider : public handler {
 #endif
   int bulk_size;
   ha_rows total_inserted_rows;
+  /* rows appended to the insert sql that is not sent yet */
+  ha_rows insert_pending_rows;
+  /*
+    remote affected rows of this statement minus the rows sent, see
+    handler::dup_resolved_rows()
+  */
+  longlong insert_dup_resolved_rows;
   int direct_dup_insert;
   int direct_insert_ignore;
   int store_error_num;
@@ -330,6 +361,7 @@ class ha_spider : public handler {
                            bool eq_range, bool sorted, bool use_parallel);
   int pre_ft_read(bool use_parallel);
   int pre_rnd_next(bool use_parallel);
+  bool pre_scan_ready();
   int info(uint flag);
   ha_rows records_in_range(uint inx, key_range *start_key, key_range *end_key);
   int check_crd();
@@ -511,6 +543,7 @@ class ha_spider : public handler {
   const COND *cond_push(const COND *cond);
   void cond_pop();
   int info_push(uint info_type, void *info);
+  longlong dup_resolved_rows();
 #ifdef HANDLER_HAS_DIRECT_AGGREGATE
   void return_record_by_parent();
 #endif
@@ -609,6 +642,8 @@ class ha_spider : public handler {
                                         ulong sql_type);
   int append_key_column_values_with_name_sql_part(const key_range *start_key,
                                                   ulong sql_type);
+  int append_point_keys_where_sql_part(SPIDER_POINT_REQ *first,
+                                       ulong sql_type);
   int append_key_where_sql_part(const key_range *start_key,
                                 const key_range *end_key, ulong sql_type);
   int append_match_where_sql_part(ulong sql_type);
@@ -670,11 +705,23 @@ class ha_spider : public handler {
   int set_union_table_name_pos_sql();
   SPIDER_CONN *spider_get_conn_by_idx(int link_idx);
   int spider_set_trx_status_info();
+  bool config_cache_usable();
+  void config_cache_free();
+  bool config_cache_match(const uchar *row, const uchar *key, uint key_len);
+  int config_cache_rnd_next(uchar *buf);
+  int config_cache_index_read(uchar *buf, const uchar *key,
+                              key_part_map keypart_map);
+  void config_cache_capture_row(const uchar *buf, int error_num);
+  bool point_batch_usable();
+  bool point_batch_index_read(uchar *buf, const uchar *key,
+                              key_part_map keypart_map, int *error_num);
+  int point_batch_query(SPIDER_POINT_BATCH *batch);
   bool is_support_column_charset() { return false; }
   bool support_more_partiton_log() { /* log sql using multiple partitions */
     return TRUE;
   }
   bool is_spider_storage_engine() { return TRUE; }
+  double collect_stats_sample_fraction() { return stats_sample_fraction; }
   bool is_spider_config_table() {
     if (this->share->tgt_config_table && this->share->tgt_config_table[0] &&
         !strncasecmp(this->share->tgt_config_table[0], "true",
@@ -62,6 +62,7 @@ mysql_rwlock_t spider_ipport_conn_rwlock;
 volatile longlong spider_conn_id = 0;
 
 extern pthread_attr_t spider_pt_attr;
+extern bool volatile *spd_abort_loop;
 
 #ifdef HAVE_PSI_INTERFACE
 extern PSI_mutex_key spd_key_mutex_mta_conn;
@@ -108,43 +109,92 @@ extern PSI_thread_key spd_key_thd_conn_rcyc;
 volatile bool conn_rcyc_init = FALSE;
 pthread_t conn_rcyc_thread;
 
+extern PSI_thread_key spd_key_thd_conn_pool_maintain;
+volatile bool conn_pool_maintain_init = FALSE;
+pthread_t conn_pool_maintain_thread;
+
 extern PSI_thread_key spd_key_thd_get_status;
 volatile bool get_status_init = FALSE;
 pthread_t get_status_thread;
-
-static const uint spider_conn_queue_init_size = 64;
-static const uint spider_conn_queue_increase_size = 64;
+volatile ulonglong spider_status_refresh_count = 0;
+volatile ulonglong spider_status_refresh_deferred = 0;
+volatile ulonglong spider_status_max_staleness = 0;
+volatile int64 spider_bgs_read_ahead_paused = 0;
+volatile int64 spider_conn_waits = 0;
+volatile int64 spider_conn_wait_timeouts = 0;
+volatile int64 spider_conn_wait_handovers = 0;
+volatile int64 spider_conn_wait_time = 0;
+volatile int64 spider_conn_wait_histogram[5] = {0, 0, 0, 0, 0};
+volatile int64 spider_conn_wait_queue_depth = 0;
+volatile ulonglong spider_point_batches = 0;
+volatile ulonglong spider_point_batch_lookups = 0;
+volatile int64 spider_bulk_update_spills = 0;
 
 /**
-  conn_queue is a queue (actually stack) to store SPIDER_CONN
-  in order to reduce memcpy the whole SPIDER_CONN, we insert
-  SPIDER_CONN ** into the queue
-  @todo: change it from stack to queue, which can increase
-         the performance of recycling.
+  conn_queue is an intrusive LRU list of idle SPIDER_CONN of one conn key,
+  linked by SPIDER_CONN::pool_newer/pool_older.
+  Connections are put back and checked out at the newest end, so the
+  warmest connection is reused first, and the oldest end is ordered by
+  the time the connection became idle, which lets the recycler expire
+  idle connections from the oldest end in O(expired).
 */
 typedef struct{
   pthread_mutex_t mtx;   // mutex of the queue
   bool mtx_inited;       // whether the mutex has inited
-  DYNAMIC_ARRAY *q_ptr;  // pointer of the queue (actually stack)
+  SPIDER_CONN *newest;   // most recently put back connection
+  SPIDER_CONN *oldest;   // longest idle connection
+  uint elements;         // number of idle connections in the queue
   char *hash_key;        // hash key of conn_queue
   uint key_len;          // length of the key
 }conn_queue;
 
 typedef struct {
-  SPIDER_CONN_POOL *hash_info;
-  DYNAMIC_STRING_ARRAY *arr_info[2];
+  time_t time_now;       // start time of this round of recycling
+  uint min_idle;         // connections kept for the pool maintainer
+  SPIDER_CONN *expired;  // expired connections linked by pool_older
 } delegate_param;
 
 /* HASH free function */
 static void conn_pool_hash_free(void *entry) {
   conn_queue *cq = (conn_queue *)entry;
-  assert(cq->q_ptr);
-  clear_dynamic_array(cq->q_ptr); /* ignore failure */
-  my_free(cq->q_ptr);
-  cq->q_ptr = NULL;
+  if (cq->mtx_inited) pthread_mutex_destroy(&cq->mtx);
   my_free(cq);
 }
 
+/* link conn at the newest end, cq->mtx must be locked */
+static inline void conn_queue_push(conn_queue *cq, SPIDER_CONN *conn) {
+  conn->pool_older = cq->newest;
+  conn->pool_newer = NULL;
+  if (cq->newest)
+    cq->newest->pool_newer = conn;
+  else
+    cq->oldest = conn;
+  cq->newest = conn;
+  cq->elements++;
+}
+
+/* unlink conn from the queue, cq->mtx must be locked */
+static inline void conn_queue_unlink(conn_queue *cq, SPIDER_CONN *conn) {
+  if (conn->pool_newer)
+    conn->pool_newer->pool_older = conn->pool_older;
+  else
+    cq->newest = conn->pool_older;
+  if (conn->pool_older)
+    conn->pool_older->pool_newer = conn->pool_newer;
+  else
+    cq->oldest = conn->pool_newer;
+  conn->pool_newer = NULL;
+  conn->pool_older = NULL;
+  cq->elements--;
+}
+
+/* newest conn not being pinged by the maintainer, cq->mtx must be locked */
+static inline SPIDER_CONN *conn_queue_newest_free(conn_queue *cq) {
+  SPIDER_CONN *conn = cq->newest;
+  while (conn && conn->pool_pinging) conn = conn->pool_older;
+  return conn;
+}
+
 /** 
   Init spider open connections
   1. init rwlock, 2. init hash
@@ -184,7 +234,6 @@ void SPIDER_CONN_POOL::destroy() {
 bool SPIDER_CONN_POOL::put_conn(SPIDER_CONN *conn) {
   void *record = NULL;
   conn_queue *cq;
-  my_bool ret;
   my_hash_value_type v = conn->conn_key_hash_value;
   
   mysql_rwlock_rdlock(&rw_lock);
@@ -192,23 +241,20 @@ bool SPIDER_CONN_POOL::put_conn(SPIDER_CONN *conn) {
           (uchar *)conn->conn_key, conn->conn_key_length))) {
     mysql_rwlock_unlock(&rw_lock);
     // if not exists, we need to create and insert a queue into the hash
-    cq = (conn_queue *)my_malloc(sizeof(conn_queue), MY_ZEROFILL | MY_WME);
+    /* the key is copied, the conn which creates the queue may be freed
+       before the queue */
+    cq = (conn_queue *)my_malloc(sizeof(conn_queue) + conn->conn_key_length,
+                                 MY_ZEROFILL | MY_WME);
     if (!cq) return true; /* OOM */
     mysql_mutex_init(0, &cq->mtx, MY_MUTEX_INIT_FAST);
     cq->mtx_inited = true;
-    cq->q_ptr = (DYNAMIC_ARRAY *)my_malloc(sizeof(DYNAMIC_ARRAY), MY_WME);
-    if (!cq->q_ptr) { my_free(cq); cq->mtx_inited = false; return true; /* OOM */ }
-    if (my_init_dynamic_array(cq->q_ptr, sizeof(SPIDER_CONN **),
-                              spider_conn_queue_init_size,
-                              spider_conn_queue_increase_size, MYF(0))) {
-      my_free(cq); cq->mtx_inited = false; return true;
-    }
-    cq->hash_key = conn->conn_key;
+    cq->hash_key = (char *)(cq + 1);
+    memcpy(cq->hash_key, conn->conn_key, conn->conn_key_length);
     cq->key_len = conn->conn_key_length;
     mysql_rwlock_wrlock(&rw_lock);
     if (my_hash_insert(&connections, (uchar *)cq)) {
       /* insert failed means some other thread has inserted it for us*/
-      my_free(cq->q_ptr);
+      pthread_mutex_destroy(&cq->mtx);
       my_free(cq);
     } else {
       record = (void *)cq;
@@ -219,9 +265,9 @@ bool SPIDER_CONN_POOL::put_conn(SPIDER_CONN *conn) {
   /* code reaches here means we got the queue */
   cq = (conn_queue *)(record);
   pthread_mutex_lock(&cq->mtx);
-  ret = insert_dynamic(cq->q_ptr, (void *)(&conn)); /* SPIDER_CONN ** */
+  conn_queue_push(cq, conn);
   pthread_mutex_unlock(&cq->mtx);
-  return !!ret; // return TRUE means OOM
+  return false;
 }
 
 /**
@@ -234,7 +280,6 @@ bool SPIDER_CONN_POOL::put_conn(SPIDER_CONN *conn) {
 SPIDER_CONN *SPIDER_CONN_POOL::get_conn(my_hash_value_type v,
                                         uchar *key, uint key_len) {
   SPIDER_CONN *spd_conn = NULL;
-  SPIDER_CONN **conn_ptr = NULL;
   conn_queue *cq = NULL;
 
   mysql_rwlock_rdlock(&rw_lock);
@@ -246,8 +291,8 @@ SPIDER_CONN *SPIDER_CONN_POOL::get_conn(my_hash_value_type v,
   mysql_rwlock_unlock(&rw_lock);
 
   pthread_mutex_lock(&cq->mtx);
-  conn_ptr = (SPIDER_CONN **)pop_dynamic(cq->q_ptr);
-  if (conn_ptr) spd_conn = *conn_ptr;
+  if ((spd_conn = conn_queue_newest_free(cq)))
+    conn_queue_unlink(cq, spd_conn);
   pthread_mutex_unlock(&cq->mtx);
   return spd_conn; /* NULL means the queue by this hash value is empty */
 }
@@ -260,7 +305,6 @@ SPIDER_CONN *SPIDER_CONN_POOL::get_conn(my_hash_value_type v,
 */
 SPIDER_CONN *SPIDER_CONN_POOL::get_conn_by_key(uchar *key, uint key_len) {
   SPIDER_CONN *spd_conn = NULL;
-  SPIDER_CONN **conn_ptr = NULL;
   conn_queue *cq = NULL;
 
   mysql_rwlock_rdlock(&rw_lock);
@@ -271,15 +315,102 @@ SPIDER_CONN *SPIDER_CONN_POOL::get_conn_by_key(uchar *key, uint key_len) {
   mysql_rwlock_unlock(&rw_lock);
 
   pthread_mutex_lock(&cq->mtx);
-  conn_ptr = (SPIDER_CONN **)pop_dynamic(cq->q_ptr);
-  if (conn_ptr) spd_conn = *conn_ptr;
+  if ((spd_conn = conn_queue_newest_free(cq)))
+    conn_queue_unlink(cq, spd_conn);
   pthread_mutex_unlock(&cq->mtx);
   return spd_conn; /* NULL means the queue by this hash key is empty */
 }
 
-/* iterate through all elements and execute my_polling_last_visited */
+/**
+  Count the idle connections in the pool using hash value
+  @param    v       hash value
+  @param    key     hash key
+  @param    key_len length of the key
+  @return   number of idle connections of this key
+*/
+uint SPIDER_CONN_POOL::idle_count(my_hash_value_type v, uchar *key,
+                                  uint key_len) {
+  uint count;
+  conn_queue *cq = NULL;
+
+  mysql_rwlock_rdlock(&rw_lock);
+  if (!(cq = (conn_queue *)my_hash_search_using_hash_value(
+        &connections, v, key, key_len))) {
+    mysql_rwlock_unlock(&rw_lock);
+    return 0; /* no queue of this hash value exist */
+  }
+  mysql_rwlock_unlock(&rw_lock);
+
+  pthread_mutex_lock(&cq->mtx);
+  count = cq->elements;
+  pthread_mutex_unlock(&cq->mtx);
+  return count;
+}
+
+/**
+  Mark the longest idle connection which is not pinged since stale_before,
+  the connection stays in the pool but is skipped by get_conn()
+  @param    v             hash value
+  @param    key           hash key
+  @param    key_len       length of the key
+  @param    stale_before  time before which last ping and use are stale
+  @return   NULL if no stale connection | SPD_CONN * to be pinged
+*/
+SPIDER_CONN *SPIDER_CONN_POOL::mark_conn_to_ping(my_hash_value_type v,
+                                                 uchar *key, uint key_len,
+                                                 time_t stale_before) {
+  SPIDER_CONN *spd_conn;
+  conn_queue *cq = NULL;
+
+  mysql_rwlock_rdlock(&rw_lock);
+  if (!(cq = (conn_queue *)my_hash_search_using_hash_value(
+        &connections, v, key, key_len))) {
+    mysql_rwlock_unlock(&rw_lock);
+    return NULL; /* no queue of this hash value exist */
+  }
+  mysql_rwlock_unlock(&rw_lock);
+
+  pthread_mutex_lock(&cq->mtx);
+  for (spd_conn = cq->oldest; spd_conn; spd_conn = spd_conn->pool_newer) {
+    if (!spd_conn->pool_pinging && spd_conn->ping_time <= stale_before &&
+        spd_conn->last_visited <= stale_before) {
+      spd_conn->pool_pinging = TRUE;
+      break;
+    }
+  }
+  pthread_mutex_unlock(&cq->mtx);
+  return spd_conn;
+}
+
+/**
+  Give a connection marked by mark_conn_to_ping() back to the pool
+  @param    conn    spider connection
+  @param    broken  whether the ping failed
+  @return   FALSE if the connection stays in the pool |
+            TRUE if it is unlinked and must be freed by the caller
+*/
+bool SPIDER_CONN_POOL::unmark_pinged_conn(SPIDER_CONN *conn, bool broken) {
+  conn_queue *cq;
+
+  mysql_rwlock_rdlock(&rw_lock);
+  cq = (conn_queue *)my_hash_search_using_hash_value(
+      &connections, conn->conn_key_hash_value, (uchar *)conn->conn_key,
+      conn->conn_key_length);
+  mysql_rwlock_unlock(&rw_lock);
+  DBUG_ASSERT(cq);
+
+  pthread_mutex_lock(&cq->mtx);
+  conn->pool_pinging = FALSE;
+  if (broken) conn_queue_unlink(cq, conn);
+  pthread_mutex_unlock(&cq->mtx);
+  return broken;
+}
+
+/* iterate through all queues and execute iter_func */
 void SPIDER_CONN_POOL::iterate(my_hash_delegate_func iter_func, void *param) {
+  mysql_rwlock_rdlock(&rw_lock);
   my_hash_delegate(&connections, iter_func, param);
+  mysql_rwlock_unlock(&rw_lock);
 }
 
 /**
@@ -399,11 +530,154 @@ int spider_free_conn_alloc(SPIDER_CONN *conn) {
   DBUG_RETURN(0);
 }
 
+/*
+  Queue a session for a connection of a saturated remote server.
+  Priority waiters are queued behind the other priority waiters, ahead of
+  the others. Called with ip_port_conn->mutex held.
+*/
+static void spider_conn_waiter_enqueue(SPIDER_IP_PORT_CONN *ip_port_conn,
+                                       SPIDER_CONN_WAITER *waiter,
+                                       bool at_head) {
+  SPIDER_CONN_WAITER *prev = NULL, *cur;
+  DBUG_ENTER("spider_conn_waiter_enqueue");
+  if (!at_head) {
+    if (waiter->priority) {
+      for (cur = ip_port_conn->waiter_first; cur && cur->priority;
+           cur = cur->next)
+        prev = cur;
+    } else
+      prev = ip_port_conn->waiter_last;
+  }
+  if (prev) {
+    waiter->next = prev->next;
+    prev->next = waiter;
+  } else {
+    waiter->next = ip_port_conn->waiter_first;
+    ip_port_conn->waiter_first = waiter;
+  }
+  if (!waiter->next) ip_port_conn->waiter_last = waiter;
+  ++ip_port_conn->waiting_count;
+  my_atomic_add64(&spider_conn_wait_queue_depth, 1);
+  DBUG_VOID_RETURN;
+}
+
+/*
+  Remove a waiter from the admission queue.
+  Called with ip_port_conn->mutex held.
+*/
+static void spider_conn_waiter_dequeue(SPIDER_IP_PORT_CONN *ip_port_conn,
+                                       SPIDER_CONN_WAITER *waiter) {
+  SPIDER_CONN_WAITER **waiter_ptr = &ip_port_conn->waiter_first, *prev = NULL;
+  DBUG_ENTER("spider_conn_waiter_dequeue");
+  while (*waiter_ptr && *waiter_ptr != waiter) {
+    prev = *waiter_ptr;
+    waiter_ptr = &prev->next;
+  }
+  if (*waiter_ptr) {
+    *waiter_ptr = waiter->next;
+    if (ip_port_conn->waiter_last == waiter) ip_port_conn->waiter_last = prev;
+    waiter->next = NULL;
+    --ip_port_conn->waiting_count;
+    my_atomic_add64(&spider_conn_wait_queue_depth, -1);
+  }
+  DBUG_VOID_RETURN;
+}
+
+/*
+  Hand a released connection directly to the first waiter.
+  A NULL conn takes the connection from the pool, for a waiter that
+  queued while the connection was being put back.
+  @return   TRUE if the connection was handed over
+*/
+static bool spider_conn_hand_over(SPIDER_IP_PORT_CONN *ip_port_conn,
+                                  SPIDER_CONN *conn,
+                                  my_hash_value_type hash_value) {
+  SPIDER_CONN_WAITER *waiter;
+  DBUG_ENTER("spider_conn_hand_over");
+  if (!ip_port_conn || !ip_port_conn->waiting_count) DBUG_RETURN(FALSE);
+  pthread_mutex_lock(&ip_port_conn->mutex);
+  if ((waiter = ip_port_conn->waiter_first) &&
+      (conn || (conn = spd_connect_pools.get_conn(
+                    hash_value, (uchar *)ip_port_conn->key,
+                    ip_port_conn->key_len)))) {
+    spider_conn_waiter_dequeue(ip_port_conn, waiter);
+    waiter->conn = conn;
+    pthread_cond_signal(&waiter->cond);
+  } else
+    waiter = NULL;
+  pthread_mutex_unlock(&ip_port_conn->mutex);
+  DBUG_RETURN(waiter != NULL);
+}
+
+/*
+  Let the first waiter create a connection in the slot of a freed one.
+*/
+static void spider_conn_waiter_grant(SPIDER_IP_PORT_CONN *ip_port_conn) {
+  SPIDER_CONN_WAITER *waiter;
+  DBUG_ENTER("spider_conn_waiter_grant");
+  if (!ip_port_conn->waiting_count) DBUG_VOID_RETURN;
+  pthread_mutex_lock(&ip_port_conn->mutex);
+  if ((waiter = ip_port_conn->waiter_first)) {
+    spider_conn_waiter_dequeue(ip_port_conn, waiter);
+    waiter->can_create = TRUE;
+    pthread_cond_signal(&waiter->cond);
+  }
+  pthread_mutex_unlock(&ip_port_conn->mutex);
+  DBUG_VOID_RETURN;
+}
+
+static void spider_conn_wait_account(ulonglong start) {
+  ulonglong wait_us = my_hrtime().val - start;
+  uint bucket;
+  DBUG_ENTER("spider_conn_wait_account");
+  my_atomic_add64(&spider_conn_wait_time, (int64)wait_us);
+  if (wait_us < 1000)
+    bucket = 0;
+  else if (wait_us < 10000)
+    bucket = 1;
+  else if (wait_us < 100000)
+    bucket = 2;
+  else if (wait_us < 1000000)
+    bucket = 3;
+  else
+    bucket = 4;
+  my_atomic_add64(&spider_conn_wait_histogram[bucket], 1);
+  DBUG_VOID_RETURN;
+}
+
+/*
+  Whether the connections of the current statement are multiplexed,
+  returned to the pool at its end whatever spider_conn_recycle_mode is.
+*/
+bool spider_conn_multiplexed(THD *thd) {
+  DBUG_ENTER("spider_conn_multiplexed");
+  DBUG_RETURN(thd && spider_param_conn_multiplex(thd) &&
+              !thd_test_options(thd, OPTION_NOT_AUTOCOMMIT | OPTION_BEGIN));
+}
+
+/*
+  Reset the remote session of a multiplexed connection after a failed
+  statement. The reset rolls back the remote transaction and drops its
+  temporary tables and user variables, then the session state recorded
+  on the connection is forgotten so that the next user sends it again.
+*/
+static int spider_conn_reset_session(SPIDER_CONN *conn, THD *thd) {
+  int error_num;
+  DBUG_ENTER("spider_conn_reset_session");
+  if ((error_num = conn->db_conn->reset_session())) {
+    DBUG_PRINT("info", ("spider failed to reset conn=%p", conn));
+    DBUG_RETURN(error_num);
+  }
+  conn->trx_start = FALSE;
+  DBUG_RETURN(spider_reset_conn_setted_parameter(conn, thd));
+}
+
 void spider_free_conn_from_trx(SPIDER_TRX *trx, SPIDER_CONN *conn, bool another,
                                bool trx_free, int *roop_count) {
   ha_spider *spider;
   SPIDER_IP_PORT_CONN *ip_port_conn = conn->ip_port_conn;
   THD *thd = current_thd;
+  bool multiplex = spider_conn_multiplexed(trx->thd);
   DBUG_ENTER("spider_free_conn_from_trx");
   spider_conn_clear_queue(conn);
   conn->use_for_active_standby = FALSE;
@@ -427,7 +701,8 @@ void spider_free_conn_from_trx(SPIDER_TRX *trx, SPIDER_CONN *conn, bool another,
   }
 
   if (trx_free ||
-      ((conn->server_lost || spider_param_conn_recycle_mode(trx->thd) != 2) &&
+      ((conn->server_lost || multiplex ||
+        spider_param_conn_recycle_mode(trx->thd) != 2) &&
        !conn->opened_handlers)) {
     conn->thd = NULL;
     if (another) {
@@ -447,35 +722,39 @@ void spider_free_conn_from_trx(SPIDER_TRX *trx, SPIDER_CONN *conn, bool another,
       conn->another_ha_last = NULL;
     } else {
       my_hash_delete(&trx->trx_conn_hash, (uchar *)conn);
+      spider_stmt_unbind_conn(trx, conn);
     }
 
     if (!trx_free && !conn->server_lost &&
         /* !conn->queued_connect &&*/
         /*  failed to create conn, don't need to free */
-        spider_param_conn_recycle_mode(trx->thd) == 1 &&
-        !(thd->is_error()) /*if thd->is_error, must be free,not recycle in the
-                              connect pool*/
-    ) {
+        (multiplex || spider_param_conn_recycle_mode(trx->thd) == 1) &&
+        /*if thd->is_error, must be free,not recycle in the connect pool*/
+        (!thd->is_error() ||
+         /* multiplexed, keep it when only the statement failed */
+         (multiplex && !thd->killed && conn->db_conn->is_connected()))) {
       /* conn_recycle_mode == 1 */
       *conn->conn_key = '0';
       conn->casual_read_base_conn = NULL;
-      if (conn->quick_target &&
-          spider_db_free_result((ha_spider *)conn->quick_target, FALSE)) {
+      if ((conn->quick_target &&
+           spider_db_free_result((ha_spider *)conn->quick_target, FALSE)) ||
+          /* the failed statement may leave a remote transaction or session
+             state behind, don't hand it to another session */
+          (thd->is_error() && spider_conn_reset_session(conn, thd))) {
         spider_free_conn(conn);
       } else {
         // pthread_mutex_lock(&spider_conn_mutex);
         // to avoid memcpy, we insert SPIDER_CONN ** to spd_connect_pools
-        if (spd_connect_pools.put_conn(conn)) {
+        my_hash_value_type hash_value = conn->conn_key_hash_value;
+        /* idle time is counted from the put-back, not the last query */
+        conn->last_visited = time(NULL);
+        if (spider_conn_hand_over(ip_port_conn, conn, hash_value)) {
+          DBUG_PRINT("info", ("spider conn handed over to a waiter"));
+        } else if (spd_connect_pools.put_conn(conn)) {
           // pthread_mutex_unlock(&spider_conn_mutex);
           spider_free_conn(conn);
         } else {
-          if (ip_port_conn) { /* exists */
-            if (ip_port_conn->waiting_count) {
-              pthread_mutex_lock(&ip_port_conn->mutex);
-              pthread_cond_signal(&ip_port_conn->cond);
-              pthread_mutex_unlock(&ip_port_conn->mutex);
-            }
-          }
+          spider_conn_hand_over(ip_port_conn, NULL, hash_value);
           /************************************************************************/
           /* Create conn_meta whose status is updated then when CONN object is
           pushed
@@ -723,6 +1002,51 @@ SPIDER_CONN *spider_create_conn(SPIDER_SHARE *share, ha_spider *spider,
   DBUG_RETURN(NULL);
 }
 
+/*
+  Partitions of a wide table usually share a few backends. The first
+  partition of a statement that resolves a conn_key binds the connection
+  here, so the other partitions of the same statement skip trx_conn_hash.
+*/
+static SPIDER_CONN *spider_stmt_bound_conn(SPIDER_TRX *trx,
+                                           SPIDER_SHARE *share, int link_idx) {
+  SPIDER_CONN *conn;
+  DBUG_ENTER("spider_stmt_bound_conn");
+  if (!trx->thd || trx->stmt_bind_query_id != trx->thd->query_id)
+    DBUG_RETURN(NULL);
+  conn = trx->stmt_bind_conns[share->conn_keys_hash_value[link_idx] %
+                              SPIDER_STMT_BIND_SLOTS];
+  if (conn && conn->conn_key_length == share->conn_keys_lengths[link_idx] &&
+      !memcmp(conn->conn_key, share->conn_keys[link_idx],
+              conn->conn_key_length)) {
+    DBUG_PRINT("info", ("spider get statement bound conn=%p", conn));
+    DBUG_RETURN(conn);
+  }
+  DBUG_RETURN(NULL);
+}
+
+static void spider_stmt_bind_conn(SPIDER_TRX *trx, SPIDER_SHARE *share,
+                                  int link_idx, SPIDER_CONN *conn) {
+  DBUG_ENTER("spider_stmt_bind_conn");
+  if (!trx->thd) DBUG_VOID_RETURN;
+  if (trx->stmt_bind_query_id != trx->thd->query_id) {
+    memset(trx->stmt_bind_conns, 0, sizeof(trx->stmt_bind_conns));
+    trx->stmt_bind_query_id = trx->thd->query_id;
+  }
+  trx->stmt_bind_conns[share->conn_keys_hash_value[link_idx] %
+                       SPIDER_STMT_BIND_SLOTS] = conn;
+  DBUG_VOID_RETURN;
+}
+
+void spider_stmt_unbind_conn(SPIDER_TRX *trx, SPIDER_CONN *conn) {
+  int roop_count;
+  DBUG_ENTER("spider_stmt_unbind_conn");
+  for (roop_count = 0; roop_count < SPIDER_STMT_BIND_SLOTS; roop_count++) {
+    if (trx->stmt_bind_conns[roop_count] == conn)
+      trx->stmt_bind_conns[roop_count] = NULL;
+  }
+  DBUG_VOID_RETURN;
+}
+
 SPIDER_CONN *spider_get_conn(SPIDER_SHARE *share, int link_idx, SPIDER_TRX *trx,
                              ha_spider *spider, bool another, bool thd_chg,
                              uint conn_kind, int *error_num) {
@@ -746,7 +1070,7 @@ SPIDER_CONN *spider_get_conn(SPIDER_SHARE *share, int link_idx, SPIDER_TRX *trx,
              &trx->trx_another_conn_hash, share->conn_keys_hash_value[link_idx],
              (uchar *)share->conn_keys[link_idx],
              share->conn_keys_lengths[link_idx]))) ||
-      (!another &&
+      (!another && !(conn = spider_stmt_bound_conn(trx, share, link_idx)) &&
        !(conn = (SPIDER_CONN *)my_hash_search_using_hash_value(
              &trx->trx_conn_hash, share->conn_keys_hash_value[link_idx],
              (uchar *)share->conn_keys[link_idx],
@@ -756,14 +1080,15 @@ SPIDER_CONN *spider_get_conn(SPIDER_SHARE *share, int link_idx, SPIDER_TRX *trx,
        !(conn = (SPIDER_CONN *)my_hash_search(
              &trx->trx_another_conn_hash, (uchar *)share->conn_keys[link_idx],
              share->conn_keys_lengths[link_idx]))) ||
-      (!another &&
+      (!another && !(conn = spider_stmt_bound_conn(trx, share, link_idx)) &&
        !(conn = (SPIDER_CONN *)my_hash_search(
              &trx->trx_conn_hash, (uchar *)share->conn_keys[link_idx],
              share->conn_keys_lengths[link_idx]))))
 #endif
   {
     if (!trx->thd || ((spider_param_conn_recycle_mode(trx->thd) & 1) ||
-                      spider_param_conn_recycle_strict(trx->thd))) {
+                      spider_param_conn_recycle_strict(trx->thd) ||
+                      spider_conn_multiplexed(trx->thd))) {
       // pthread_mutex_lock(&spider_conn_mutex);
       if (!(conn = spd_connect_pools.get_conn(
                 share->conn_keys_hash_value[link_idx],
@@ -849,6 +1174,7 @@ SPIDER_CONN *spider_get_conn(SPIDER_SHARE *share, int link_idx, SPIDER_TRX *trx,
       conn->use_for_active_standby = TRUE;
   }
   conn->link_idx = base_link_idx;
+  if (!another) spider_stmt_bind_conn(trx, share, link_idx, conn);
 
   if (conn->queued_connect)
     spider_conn_queue_connect_rewrite(share, conn, link_idx);
@@ -875,6 +1201,7 @@ int spider_free_conn(SPIDER_CONN *conn) {
     pthread_mutex_lock(&ip_port_conn->mutex);
     if (ip_port_conn->ip_port_count > 0) ip_port_conn->ip_port_count--;
     pthread_mutex_unlock(&ip_port_conn->mutex);
+    spider_conn_waiter_grant(ip_port_conn);
   }
   conn->bg_conn_working = false;
   spider_free_conn_alloc(conn);
@@ -1266,6 +1593,9 @@ int spider_set_conn_bg_param(ha_spider *spider) {
     result_list->bgs_phase = 0;
   else {
     result_list->bgs_phase = 1;
+    result_list->bgs_stored = NULL;
+    result_list->bgs_read_ahead = spider_param_bgs_read_ahead(thd);
+    result_list->bgs_read_ahead_limit = spider_param_bgs_read_ahead_size(thd);
 
     result_list->bgs_split_read = spider_bg_split_read_param(spider);
     if (spider->use_pre_call) {
@@ -1339,11 +1669,14 @@ int spider_set_conn_bg_param_for_dml(ha_spider *spider) {
   5. not in transaction
   6. spider_rone_shard_flag==FALSE
   7. just one table included
-  8. don't support limit*/
+  8. don't support limit, except delete without order by whose limit
+     ha_partition splits across the partitions (thd->direct_limit)*/
   /* TODO  set dml_bgs_mode = 1 when involving multiple partitions */
   if (thd && select_lex &&
       (!(select_lex->explicit_limit || select_lex->offset_limit ||
-         select_lex->select_limit)) &&
+         select_lex->select_limit) ||
+       (thd->lex->sql_command == SQLCOM_DELETE && thd->direct_limit > 0 &&
+        !select_lex->order_list.elements)) &&
       (thd->lex->sql_command == SQLCOM_INSERT ||
        thd->lex->sql_command == SQLCOM_UPDATE ||
        thd->lex->sql_command == SQLCOM_DELETE ||
@@ -1532,7 +1865,9 @@ void spider_free_conn_thread(SPIDER_CONN *conn) {
 void spider_bg_conn_wait(SPIDER_CONN *conn) {
   DBUG_ENTER("spider_bg_conn_wait");
   if (conn->bg_init) {
+    thd_wait_begin(NULL, THD_WAIT_NET);
     pthread_mutex_lock(&conn->bg_conn_mutex);
+    thd_wait_end(NULL);
     pthread_mutex_unlock(&conn->bg_conn_mutex);
   }
   DBUG_VOID_RETURN;
@@ -1659,6 +1994,107 @@ bool spider_bg_conn_get_job(SPIDER_CONN *conn) {
   DBUG_RETURN(TRUE);
 }
 
+/*
+  Estimate the memory held by batches that were read ahead of the one
+  being consumed. Rows are counted at the record length of the table.
+*/
+static longlong spider_bg_read_ahead_size(ha_spider *spider) {
+  SPIDER_RESULT_LIST *result_list = &spider->result_list;
+  SPIDER_RESULT *result = (SPIDER_RESULT *)result_list->current;
+  longlong size = 0;
+  DBUG_ENTER("spider_bg_read_ahead_size");
+  if (!result || !result_list->bgs_stored) DBUG_RETURN(0);
+  while (result != result_list->bgs_stored && result->next) {
+    result = (SPIDER_RESULT *)result->next;
+    size += result->record_num * result_list->table->s->reclength;
+  }
+  DBUG_RETURN(size);
+}
+
+/*
+  Publish the read ahead size of this handler to its transaction, so that
+  all scans of one session share spider_bgs_read_ahead_size.
+*/
+void spider_bg_set_read_ahead_size(ha_spider *spider, longlong size) {
+  SPIDER_RESULT_LIST *result_list = &spider->result_list;
+  DBUG_ENTER("spider_bg_set_read_ahead_size");
+  if (result_list->bgs_read_ahead_trx &&
+      result_list->bgs_read_ahead_trx == spider->trx) {
+    my_atomic_add64(&spider->trx->bgs_read_ahead_size,
+                    size - result_list->bgs_read_ahead_size);
+  } else if (spider->trx) {
+    my_atomic_add64(&spider->trx->bgs_read_ahead_size, size);
+  }
+  result_list->bgs_read_ahead_trx = spider->trx;
+  result_list->bgs_read_ahead_size = spider->trx ? size : 0;
+  DBUG_VOID_RETURN;
+}
+
+/*
+  Whether the background thread may search one more batch before the
+  caller has consumed the stored ones. Called with bg_conn_mutex held.
+*/
+static bool spider_bg_can_read_ahead(ha_spider *spider, SPIDER_CONN *conn) {
+  SPIDER_RESULT_LIST *result_list = &spider->result_list;
+  volatile SPIDER_RESULT *result;
+  uint batches = 0;
+  DBUG_ENTER("spider_bg_can_read_ahead");
+  if (result_list->bgs_read_ahead <= 1 || result_list->bgs_phase != 3 ||
+      result_list->bgs_caller_waiting || result_list->bgs_error ||
+      conn->bg_discard_result || conn->bg_kill || conn->bg_break ||
+      spider->use_fields ||
+      spider_conn_lock_mode(spider) != SPIDER_LOCK_MODE_NO_LOCK ||
+      !result_list->current || result_list->bgs_current->finish_flg ||
+      result_list->record_num >= result_list->internal_limit)
+    DBUG_RETURN(FALSE);
+  for (result = result_list->current;
+       result && result != result_list->bgs_current; result = result->next)
+    batches++;
+  if (batches >= result_list->bgs_read_ahead) DBUG_RETURN(FALSE);
+  if (result_list->bgs_read_ahead_trx &&
+      my_atomic_load64(&result_list->bgs_read_ahead_trx->bgs_read_ahead_size) >=
+          result_list->bgs_read_ahead_limit) {
+    my_atomic_add64(&spider_bgs_read_ahead_paused, 1);
+    DBUG_RETURN(FALSE);
+  }
+  DBUG_RETURN(TRUE);
+}
+
+/*
+  Set the limit of the next split_read batch to the search sql.
+*/
+static int spider_bg_set_next_search(ha_spider *spider) {
+  int error_num;
+  SPIDER_RESULT_LIST *result_list = &spider->result_list;
+  DBUG_ENTER("spider_bg_set_next_search");
+  if (result_list->quick_mode == 0 || !result_list->bgs_current->result) {
+    result_list->split_read = result_list->bgs_split_read;
+    result_list->limit_num =
+        result_list->internal_limit - result_list->record_num >=
+                result_list->split_read
+            ? result_list->split_read
+            : result_list->internal_limit - result_list->record_num;
+    DBUG_PRINT("info", ("spider sql_kinds=%u", spider->sql_kinds));
+    if (spider->sql_kinds & SPIDER_SQL_KIND_SQL) {
+      if ((error_num = spider->reappend_limit_sql_part(
+               result_list->internal_offset + result_list->record_num,
+               result_list->limit_num, SPIDER_SQL_TYPE_SELECT_SQL)))
+        DBUG_RETURN(error_num);
+      if (!result_list->use_union &&
+          (error_num = spider->append_select_lock_sql_part(
+               SPIDER_SQL_TYPE_SELECT_SQL)))
+        DBUG_RETURN(error_num);
+    }
+    if (spider->sql_kinds & SPIDER_SQL_KIND_HANDLER) {
+      spider_db_append_handler_next(spider);
+      if ((error_num = spider->reappend_limit_sql_part(
+               0, result_list->limit_num, SPIDER_SQL_TYPE_HANDLER)))
+        DBUG_RETURN(error_num);
+    }
+  }
+  DBUG_RETURN(0);
+}
+
 int spider_bg_conn_search(ha_spider *spider, int link_idx, int first_link_idx,
                           bool first, bool pre_next, bool discard_result,
                           ulong sql_type) {
@@ -1687,6 +2123,7 @@ int spider_bg_conn_search(ha_spider *spider, int link_idx, int first_link_idx,
       DBUG_PRINT("info", ("spider bg first search"));
       pthread_mutex_lock(&conn->bg_conn_mutex);
       result_list->sql_type = sql_type;
+      result_list->bgs_stored = NULL;
       result_list->bgs_working = TRUE;
       conn->bg_search = TRUE;
       conn->bg_caller_wait = TRUE;
@@ -1701,9 +2138,11 @@ int spider_bg_conn_search(ha_spider *spider, int link_idx, int first_link_idx,
           &conn->bg_conn_sync_mutex);  // must ensure: before signal backend is wait
       pthread_cond_signal(&conn->bg_conn_cond);
       pthread_mutex_unlock(&conn->bg_conn_mutex);
+      thd_wait_begin(thd, THD_WAIT_NET);
       pthread_cond_wait(&conn->bg_conn_sync_cond,
                         &conn->bg_conn_sync_mutex);  // also ok if don't wait
                                                      // ? handshake ?
+      thd_wait_end(thd);
       pthread_mutex_unlock(&conn->bg_conn_sync_mutex);
       conn->bg_caller_wait = FALSE;
       if (sql_type != SPIDER_SQL_TYPE_SELECT_SQL)
@@ -1850,67 +2289,76 @@ int spider_bg_conn_search(ha_spider *spider, int link_idx, int first_link_idx,
       result_list->table->status = STATUS_NOT_FOUND;
       DBUG_RETURN(HA_ERR_END_OF_FILE);
     }
-    if (result_list->bgs_working) {
-      /* wait */
-      DBUG_PRINT("info", ("spider bg working wait"));
-      thd_proc_info(thd, "Waiting bg action done");
+    if (result_list->bgs_stored &&
+        result_list->current != result_list->bgs_stored) {
+      /*
+        the next batch is already read ahead. The background thread walks
+        the list from current while it works, so move on under its mutex
+        and keep it from chaining more searches meanwhile.
+      */
+      DBUG_PRINT("info", ("spider bg read ahead"));
+      result_list->bgs_caller_waiting = TRUE;
+      thd_wait_begin(thd, THD_WAIT_NET);
       pthread_mutex_lock(&conn->bg_conn_mutex);
-      result_list->sql_type = sql_type;
+      thd_wait_end(thd);
+      result_list->bgs_caller_waiting = FALSE;
+      result_list->current = result_list->current->next;
+      result_list->current_row_num = 0;
       pthread_mutex_unlock(&conn->bg_conn_mutex);
-    }
-    if (result_list->bgs_error) {
-      DBUG_PRINT("info", ("spider bg error"));
-      if (result_list->bgs_error == HA_ERR_END_OF_FILE) {
-        result_list->current = result_list->current->next;
-        result_list->current_row_num = 0;
-        result_list->table->status = STATUS_NOT_FOUND;
+    } else {
+      if (result_list->bgs_working) {
+        /* wait */
+        DBUG_PRINT("info", ("spider bg working wait"));
+        thd_proc_info(thd, "Waiting bg action done");
+        result_list->bgs_caller_waiting = TRUE;
+        thd_wait_begin(thd, THD_WAIT_NET);
+        pthread_mutex_lock(&conn->bg_conn_mutex);
+        thd_wait_end(thd);
+        result_list->sql_type = sql_type;
+        result_list->bgs_caller_waiting = FALSE;
+        pthread_mutex_unlock(&conn->bg_conn_mutex);
+      }
+      if (result_list->bgs_error) {
+        DBUG_PRINT("info", ("spider bg error"));
+        if (result_list->bgs_error == HA_ERR_END_OF_FILE) {
+          result_list->current = result_list->current->next;
+          result_list->current_row_num = 0;
+          result_list->table->status = STATUS_NOT_FOUND;
+        }
+        if (result_list->bgs_error_with_message)
+          my_message(result_list->bgs_error, result_list->bgs_error_msg,
+                     MYF(0));
+        DBUG_RETURN(result_list->bgs_error);
       }
-      if (result_list->bgs_error_with_message)
-        my_message(result_list->bgs_error, result_list->bgs_error_msg, MYF(0));
-      DBUG_RETURN(result_list->bgs_error);
+      result_list->current = result_list->current->next;
+      result_list->current_row_num = 0;
     }
-    result_list->current = result_list->current->next;
-    result_list->current_row_num = 0;
-    if (result_list->current == result_list->bgs_current) {
+    if (result_list->current == result_list->bgs_current ||
+        !result_list->bgs_working) {
       assert(sql_type == SPIDER_SQL_TYPE_SELECT_SQL);
-      DBUG_PRINT("info", ("spider bg next search"));
-      if (!result_list->current->finish_flg) {
+      if (result_list->bgs_working) {
+        result_list->bgs_caller_waiting = TRUE;
+        thd_wait_begin(thd, THD_WAIT_NET);
+        pthread_mutex_lock(&conn->bg_conn_mutex);
+        thd_wait_end(thd);
+      } else
+        pthread_mutex_lock(&conn->bg_conn_mutex);
+      result_list->bgs_caller_waiting = FALSE;
+      spider_bg_set_read_ahead_size(spider, spider_bg_read_ahead_size(spider));
+      if (result_list->bgs_current->finish_flg || result_list->bgs_error ||
+          (result_list->current != result_list->bgs_current &&
+           !spider_bg_can_read_ahead(spider, conn))) {
+        pthread_mutex_unlock(&conn->bg_conn_mutex);
+      } else {
+        DBUG_PRINT("info", ("spider bg next search"));
         DBUG_PRINT("info", ("spider result_list->quick_mode=%d",
                             result_list->quick_mode));
         DBUG_PRINT("info", ("spider result_list->bgs_current->result=%p",
                             result_list->bgs_current->result));
-        pthread_mutex_lock(&conn->bg_conn_mutex);
         result_list->bgs_phase = 3;
-        if (result_list->quick_mode == 0 || !result_list->bgs_current->result) {
-          result_list->split_read = result_list->bgs_split_read;
-          result_list->limit_num =
-              result_list->internal_limit - result_list->record_num >=
-                      result_list->split_read
-                  ? result_list->split_read
-                  : result_list->internal_limit - result_list->record_num;
-          DBUG_PRINT("info", ("spider sql_kinds=%u", spider->sql_kinds));
-          if (spider->sql_kinds & SPIDER_SQL_KIND_SQL) {
-            if ((error_num = spider->reappend_limit_sql_part(
-                     result_list->internal_offset + result_list->record_num,
-                     result_list->limit_num, SPIDER_SQL_TYPE_SELECT_SQL))) {
-              pthread_mutex_unlock(&conn->bg_conn_mutex);
-              DBUG_RETURN(error_num);
-            }
-            if (!result_list->use_union &&
-                (error_num = spider->append_select_lock_sql_part(
-                     SPIDER_SQL_TYPE_SELECT_SQL))) {
-              pthread_mutex_unlock(&conn->bg_conn_mutex);
-              DBUG_RETURN(error_num);
-            }
-          }
-          if (spider->sql_kinds & SPIDER_SQL_KIND_HANDLER) {
-            spider_db_append_handler_next(spider);
-            if ((error_num = spider->reappend_limit_sql_part(
-                     0, result_list->limit_num, SPIDER_SQL_TYPE_HANDLER))) {
-              pthread_mutex_unlock(&conn->bg_conn_mutex);
-              DBUG_RETURN(error_num);
-            }
-          }
+        if ((error_num = spider_bg_set_next_search(spider))) {
+          pthread_mutex_unlock(&conn->bg_conn_mutex);
+          DBUG_RETURN(error_num);
         }
         conn->bg_target = spider;
         conn->link_idx = link_idx;
@@ -1955,7 +2403,9 @@ void spider_bg_conn_simple_action(SPIDER_CONN *conn, uint simple_action,
   pthread_cond_signal(&conn->bg_conn_cond);
   pthread_mutex_unlock(&conn->bg_conn_mutex);
   if (caller_wait) {
+    thd_wait_begin(NULL, THD_WAIT_NET);
     pthread_cond_wait(&conn->bg_conn_sync_cond, &conn->bg_conn_sync_mutex);
+    thd_wait_end(NULL);
     pthread_mutex_unlock(&conn->bg_conn_sync_mutex);
     conn->bg_caller_wait = FALSE;
   } else {
@@ -2013,6 +2463,7 @@ void *spider_bg_conn_action(void *arg) {
 
   while (TRUE) {
     bool set_sql = false;
+    longlong insert_sent_rows = -1;
     if (conn->bg_conn_chain_mutex_ptr) {
       pthread_mutex_unlock(conn->bg_conn_chain_mutex_ptr);
       conn->bg_conn_chain_mutex_ptr = NULL;
@@ -2039,6 +2490,7 @@ void *spider_bg_conn_action(void *arg) {
       if (result_list->sql_type == SPIDER_SQL_TYPE_INSERT_SQL) {
         result_list->bgs_error = 0;
         result_list->bgs_error_with_message = FALSE;
+        insert_sent_rows = conn->bg_insert_sent_rows;
         // sql should be set before signal
         if ((error_num = dbton_handler->set_sql_for_exec(
                  result_list->sql_type, conn->link_idx, true))) {
@@ -2098,6 +2550,7 @@ void *spider_bg_conn_action(void *arg) {
       share = spider->share;
       dbton_handler = spider->dbton_handler[conn->dbton_id];
       result_list = &spider->result_list;
+    bg_search_read_ahead:
       result_list->bgs_error = 0;
       result_list->bgs_error_with_message = FALSE;
       if (result_list->quick_mode == 0 || result_list->bgs_phase == 1 ||
@@ -2179,6 +2632,11 @@ void *spider_bg_conn_action(void *arg) {
                            spider_stmt_da_message(thd));
                 } else {
                   spider->connection_ids[conn->link_idx] = conn->connection_id;
+                  if (sql_type == SPIDER_SQL_TYPE_INSERT_SQL &&
+                      insert_sent_rows >= 0)
+                    spider->insert_dup_resolved_rows +=
+                        (longlong)conn->db_conn->affected_rows() -
+                        insert_sent_rows;
                   if (!conn->bg_discard_result) {
                     if (!(result_list->bgs_error = spider_db_store_result(
                               spider, conn->link_idx, result_list->table)))
@@ -2217,6 +2675,21 @@ void *spider_bg_conn_action(void *arg) {
           strmov(result_list->bgs_error_msg, spider_stmt_da_message(thd));
         conn->mta_conn_mutex_unlock_later = FALSE;
       }
+      if (!result_list->bgs_error && !conn->bg_discard_result &&
+          result_list->bgs_read_ahead > 1) {
+        result_list->bgs_stored = result_list->bgs_current;
+        spider_bg_set_read_ahead_size(spider,
+                                      spider_bg_read_ahead_size(spider));
+        if (spider_bg_can_read_ahead(spider, conn)) {
+          DBUG_PRINT("info", ("spider bg search read ahead"));
+          result_list->bgs_phase = 3;
+          if (!(error_num = spider_bg_set_next_search(spider)))
+            goto bg_search_read_ahead;
+          result_list->bgs_error = error_num;
+          if ((result_list->bgs_error_with_message = thd->is_error()))
+            strmov(result_list->bgs_error_msg, spider_stmt_da_message(thd));
+        }
+      }
       conn->bg_search = FALSE;
       result_list->bgs_working = FALSE;
       if (conn->bg_caller_wait) {
@@ -3234,6 +3707,12 @@ int spider_conn_first_link_idx(THD *thd, long *link_statuses,
   int *link_idxs, link_idx;
   long *balances;
   DBUG_ENTER("spider_conn_first_link_idx");
+  if (link_count == 1) {
+    /* nothing to balance, so skip the work area and the random draw */
+    if (link_statuses[conn_link_idx[0]] <= link_status) DBUG_RETURN(0);
+    DBUG_PRINT("info", ("spider all links are failed"));
+    DBUG_RETURN(-1);
+  }
   char *ptr;
   ptr = (char *)my_alloca((sizeof(int) * link_count) +
                           (sizeof(long) * link_count));
@@ -3453,49 +3932,71 @@ SPIDER_CONN *spider_get_conn_from_idle_connection(
   if (ip_port_conn && ip_port_count >= spider_max_connections &&
       spider_max_connections >
           0) { /* no idle conn && enable connection pool, wait */
-    pthread_mutex_unlock(&ip_port_conn->mutex);
+    SPIDER_CONN_WAITER waiter;
+    bool at_head = FALSE;
+    mysql_cond_init(spd_key_cond_conn_i, &waiter.cond, NULL);
+    waiter.priority = spider && spider->trx &&
+                      spider_param_conn_wait_priority(spider->trx->thd);
     start = my_hrtime().val;
+    my_atomic_add64(&spider_conn_waits, 1);
     while (1) {
-      int error;
-      inter_val = my_hrtime().val - start;        // us
-      last_ntime = wait_time - inter_val * 1000;  // *1000, to ns
-      if (last_ntime <= 0) {                      /* wait timeout */
-        *error_num = ER_SPIDER_CON_COUNT_ERROR;
-        DBUG_RETURN(NULL);
-      }
-      set_timespec_nsec(abstime, last_ntime);
-      pthread_mutex_lock(&ip_port_conn->mutex);
-      ++ip_port_conn->waiting_count;
-      error = pthread_cond_timedwait(&ip_port_conn->cond, &ip_port_conn->mutex,
-                                     &abstime);
-      --ip_port_conn->waiting_count;
-      pthread_mutex_unlock(&ip_port_conn->mutex);
-      if (error == ETIMEDOUT || error == ETIME || error != 0) {
-        *error_num = ER_SPIDER_CON_COUNT_ERROR;
-        DBUG_RETURN(NULL);
-      }
-
-      // pthread_mutex_lock(&spider_conn_mutex);
-      if ((conn = spd_connect_pools.get_conn(
+      int error = 0;
+      waiter.conn = NULL;
+      waiter.can_create = FALSE;
+      spider_conn_waiter_enqueue(ip_port_conn, &waiter, at_head);
+      /* a connection may have been put back before we were queued */
+      if ((waiter.conn = spd_connect_pools.get_conn(
                share->conn_keys_hash_value[link_idx],
                (uchar *)share->conn_keys[link_idx],
                share->conn_keys_lengths[link_idx])))
-      {
-        /* get conn from spider_open_connections, then delete conn in
-         * spider_open_connections */
-        // my_hash_delete(&spider_open_connections, (uchar *)conn);
-        // pthread_mutex_unlock(&spider_conn_mutex);
-        DBUG_PRINT("info", ("spider get global conn"));
-        if (spider) {
-          spider->conns[base_link_idx] = conn;
-          if (spider_bit_is_set(spider->conn_can_fo, base_link_idx))
-            conn->use_for_active_standby = TRUE;
+        spider_conn_waiter_dequeue(ip_port_conn, &waiter);
+      thd_wait_begin(NULL, THD_WAIT_NET);
+      while (!waiter.conn && !waiter.can_create && !error) {
+        inter_val = my_hrtime().val - start;        // us
+        last_ntime = wait_time - inter_val * 1000;  // *1000, to ns
+        if (last_ntime <= 0) {                      /* wait timeout */
+          error = ETIMEDOUT;
+          break;
         }
-        DBUG_RETURN(conn);
+        set_timespec_nsec(abstime, last_ntime);
+        error = pthread_cond_timedwait(&waiter.cond, &ip_port_conn->mutex,
+                                       &abstime);
+        if (error != ETIMEDOUT && error != ETIME) error = 0;
+      }
+      thd_wait_end(NULL);
+      if (!waiter.conn && !waiter.can_create)
+        spider_conn_waiter_dequeue(ip_port_conn, &waiter);
+      pthread_mutex_unlock(&ip_port_conn->mutex);
+      if (waiter.can_create) {
+        /* a connection was freed, its slot is ours */
+        DBUG_PRINT("info", ("spider create new conn after wait"));
+        if ((conn = spider_create_conn(share, spider, link_idx, base_link_idx,
+                                       conn_kind, error_num)))
+          *conn->conn_key = *conn_key;
+        else if (*error_num == ER_SPIDER_CON_COUNT_ERROR) {
+          /* the slot was taken by a new session, wait again at the head */
+          at_head = TRUE;
+          pthread_mutex_lock(&ip_port_conn->mutex);
+          continue;
+        } else
+          spider_conn_waiter_grant(ip_port_conn);
+      } else if ((conn = waiter.conn)) {
+        DBUG_PRINT("info", ("spider get handed over conn"));
+        my_atomic_add64(&spider_conn_wait_handovers, 1);
       } else {
-        // pthread_mutex_unlock(&spider_conn_mutex);
+        my_atomic_add64(&spider_conn_wait_timeouts, 1);
+        *error_num = ER_SPIDER_CON_COUNT_ERROR;
       }
+      break;
     }
+    pthread_cond_destroy(&waiter.cond);
+    spider_conn_wait_account(start);
+    if (conn && spider) {
+      spider->conns[base_link_idx] = conn;
+      if (spider_bit_is_set(spider->conn_can_fo, base_link_idx))
+        conn->use_for_active_standby = TRUE;
+    }
+    DBUG_RETURN(conn);
   } else { /* create conn */
     if (ip_port_conn) pthread_mutex_unlock(&ip_port_conn->mutex);
     DBUG_PRINT("info", ("spider create new conn"));
@@ -3589,130 +4090,52 @@ void spider_free_ipport_conn(void *info) {
   DBUG_VOID_RETURN;
 }
 
-static my_bool my_polling_last_visited(uchar *entry, void *data) {
-  DBUG_ENTER("my_polling_last_visited");
-  SPIDER_CONN *conn = (SPIDER_CONN *)entry;
-  delegate_param *param = (delegate_param *)data;
-  DYNAMIC_STRING_ARRAY **arr_info = param->arr_info;
-  if (conn) {
-    time_t time_now = time((time_t *)0);
-    if (time_now > 0 && time_now > conn->last_visited &&
-        time_now - conn->last_visited >=
-            spider_param_idle_conn_recycle_interval()) {
-#ifdef SPIDER_HAS_HASH_VALUE_TYPE
-      append_dynamic_string_array(arr_info[0],
-                                  (char *)&conn->conn_key_hash_value,
-                                  sizeof(conn->conn_key_hash_value));
-#else
-      SPD_OPEN_CONN *soc = param->hash_info;
-      my_hash_value_type hash_value = soc->calc_hash(
-          conn->conn_key, conn->conn_key_length);
-      append_dynamic_string_array(arr_info[0], (char *)&hash_value,
-                                  sizeof(hash_value));
-#endif
-      append_dynamic_string_array(arr_info[1], (char *)conn->conn_key,
-                                  conn->conn_key_length);
-    }
-
-  }
-  return 0;
-}
-
 /*
-  new my_polling_last_visited() used by SPIDER_CONN_POOL::iterate()
+  expire_idle_conns() used by SPIDER_CONN_POOL::iterate()
+  unlink expired connections from the oldest end of the queue, the
+  connections are freed by the caller after the queue mutex is released
 */
-static my_bool poll_last_visited(uchar *entry, void *data) {
-  DBUG_ENTER("my_polling_last_visited");
+static my_bool expire_idle_conns(uchar *entry, void *data) {
+  DBUG_ENTER("expire_idle_conns");
   conn_queue *cq = (conn_queue *)entry;
-  void *buffer = NULL;
-  bool buffer_malloced = false;
-  if (!cq || !cq->q_ptr) return FALSE; /* queue is empty */
+  delegate_param *param = (delegate_param *)data;
+  SPIDER_CONN *conn;
+  time_t interval = spider_param_idle_conn_recycle_interval();
+  if (!cq) DBUG_RETURN(FALSE);
   assert(cq->mtx_inited);
+  /* the queue is read under its mutex only, put_conn() and get_conn()
+     relink it concurrently */
   pthread_mutex_lock(&cq->mtx);
-  /* this may be the bottleneck, since we do a mutex lock and walk
-     through the whole array, memcpy (used by get_dynamic) might also
-     account for the overhead
-  */
-  for (uint i = 0; i < cq->q_ptr->elements; i++) {
-    if (!buffer_malloced) {
-      buffer = my_malloc(sizeof(SPIDER_CONN **), MY_WME);
-      if (!buffer) return TRUE; /* OOM */
-      buffer_malloced = true;
-    }
-    get_dynamic(cq->q_ptr, buffer, i);
-    SPIDER_CONN *conn = *(SPIDER_CONN **)buffer;
-    delegate_param *param = (delegate_param *)data;
-    DYNAMIC_STRING_ARRAY **arr_info = param->arr_info;
-    if (conn) {
-      time_t time_now = time((time_t *)0);
-      if (time_now > 0 && time_now > conn->last_visited &&
-          time_now - conn->last_visited >=
-              spider_param_idle_conn_recycle_interval()) {
-        append_dynamic_string_array(arr_info[0],
-                                    (char *)&conn->conn_key_hash_value,
-                                    sizeof(conn->conn_key_hash_value));
-        append_dynamic_string_array(arr_info[1], (char *)conn->conn_key,
-                                    conn->conn_key_length);
-      }
-    } 
+  /* the newest min_idle connections are kept for the pool maintainer,
+     they are validated by ping instead */
+  while ((conn = cq->oldest) && cq->elements > param->min_idle &&
+         !conn->pool_pinging && param->time_now > conn->last_visited &&
+         param->time_now - conn->last_visited >= interval) {
+    conn_queue_unlink(cq, conn);
+    conn->pool_older = param->expired;
+    param->expired = conn;
   }
   pthread_mutex_unlock(&cq->mtx);
-  if (buffer_malloced) {
-    my_free(buffer);
-    buffer = NULL;
-  }
-  return FALSE;
+  DBUG_RETURN(FALSE);
 }
 
 static void *spider_conn_recycle_action(void *arg) {
   DBUG_ENTER("spider_conn_recycle_action");
-  DYNAMIC_STRING_ARRAY idle_conn_key_hash_value_arr;
-  DYNAMIC_STRING_ARRAY idle_conn_key_arr;
-
-  if (init_dynamic_string_array(&idle_conn_key_hash_value_arr, 64, 64) ||
-      init_dynamic_string_array(&idle_conn_key_arr, 64, 64)) {
-    DBUG_RETURN(NULL);
-  }
-
+  SPIDER_CONN *conn;
   delegate_param param;
-  param.hash_info = &spd_connect_pools;
-  param.arr_info[0] = &idle_conn_key_hash_value_arr;
-  param.arr_info[1] = &idle_conn_key_arr;
-  while (conn_rcyc_init) {
-    clear_dynamic_string_array(&idle_conn_key_hash_value_arr);
-    clear_dynamic_string_array(&idle_conn_key_arr);
-
-    // pthread_mutex_lock(&spider_conn_mutex);
-    // my_hash_delegate(&spider_open_connections, my_polling_last_visited, &param);
-    // pthread_mutex_unlock(&spider_conn_mutex);
-    spd_connect_pools.iterate((my_hash_delegate_func)poll_last_visited, &param);
-
-    for (size_t i = 0; i < idle_conn_key_hash_value_arr.cur_idx; ++i) {
-      my_hash_value_type *tmp_ptr = NULL;
-      if (get_dynamic_string_array(&idle_conn_key_hash_value_arr,
-                                   (char **)&tmp_ptr, NULL, i)) {
-        spider_my_err_logging(
-            "[ERROR] fill tmp_ptr error by idle_conn_key_hash_value_arr!\n");
-        break;
-      }
 
-      char *conn_key = NULL;
-      size_t conn_key_len;
-      my_hash_value_type conn_key_hash_value = *tmp_ptr;
-      if (get_dynamic_string_array(&idle_conn_key_arr, &conn_key, &conn_key_len,
-                                   i)) {
-        spider_my_err_logging(
-            "[ERROR] fill conn_key error from idle_conn_key_arr!\n");
-        break;
-      }
-      // pthread_mutex_lock(&spider_conn_mutex);
-      SPIDER_CONN *conn = spd_connect_pools.get_conn(conn_key_hash_value, 
-          (uchar *)conn_key, conn_key_len); 
-      // pthread_mutex_unlock(&spider_conn_mutex);
-      if (conn) {
-        spider_update_conn_meta_info(conn, SPIDER_CONN_INVALID_STATUS);
-        spider_free_conn(conn);
-      }
+  while (conn_rcyc_init) {
+    param.time_now = time((time_t *)0);
+    param.min_idle = spider_param_conn_pool_min_idle();
+    param.expired = NULL;
+    spd_connect_pools.iterate((my_hash_delegate_func)expire_idle_conns,
+                              &param);
+
+    while ((conn = param.expired)) {
+      param.expired = conn->pool_older;
+      conn->pool_older = NULL;
+      spider_update_conn_meta_info(conn, SPIDER_CONN_INVALID_STATUS);
+      spider_free_conn(conn);
     }
 
     /* NOTE: In worst case, idle connection would be freed in 1.25 *
@@ -3729,8 +4152,6 @@ static void *spider_conn_recycle_action(void *arg) {
     }
   }
 
-  free_dynamic_string_array(&idle_conn_key_hash_value_arr);
-  free_dynamic_string_array(&idle_conn_key_arr);
   DBUG_RETURN(NULL);
 }
 
@@ -3741,6 +4162,8 @@ int spider_create_conn_recycle_thread() {
     DBUG_RETURN(0);
   }
 
+  /* set before the thread starts, it leaves its loop once this is FALSE */
+  conn_rcyc_init = TRUE;
 #if MYSQL_VERSION_ID < 50500
   if (pthread_create(&conn_rcyc_thread, NULL, spider_conn_recycle_action, NULL))
 #else
@@ -3748,10 +4171,10 @@ int spider_create_conn_recycle_thread() {
                           spider_conn_recycle_action, NULL))
 #endif
   {
+    conn_rcyc_init = FALSE;
     error_num = HA_ERR_OUT_OF_MEM;
     goto error_thread_create;
   }
-  conn_rcyc_init = TRUE;
   DBUG_RETURN(0);
 
 error_thread_create:
@@ -3768,6 +4191,202 @@ void spider_free_conn_recycle_thread() {
   DBUG_VOID_RETURN;
 }
 
+/**
+  Validate the idle connections of one remote server and top them up
+  to spider_conn_pool_min_idle
+  @param    thd       THD of the maintainer thread
+  @param    server    remote server registered in mysql.servers
+  @param    min_idle  number of idle connections to keep
+*/
+static void spider_conn_pool_maintain_server(THD *thd, FOREIGN_SERVER *server,
+                                             uint min_idle) {
+  int error_num;
+  uint idle;
+  bool broken;
+  SPIDER_CONN *conn;
+  SPIDER_SHARE tmp_share;
+  char *tmp_connect_info[SPIDER_TMP_SHARE_CHAR_PTR_COUNT];
+  uint tmp_connect_info_length[SPIDER_TMP_SHARE_UINT_COUNT];
+  long tmp_long[SPIDER_TMP_SHARE_LONG_COUNT];
+  longlong tmp_longlong[SPIDER_TMP_SHARE_LONGLONG_COUNT];
+  time_t time_now, stale_before;
+  DBUG_ENTER("spider_conn_pool_maintain_server");
+
+  memset(&tmp_share, 0, sizeof(SPIDER_SHARE));
+  memset(&tmp_connect_info, 0,
+         sizeof(char *) * SPIDER_TMP_SHARE_CHAR_PTR_COUNT);
+  memset(tmp_connect_info_length, 0,
+         sizeof(uint) * SPIDER_TMP_SHARE_UINT_COUNT);
+  memset(tmp_long, 0, sizeof(long) * SPIDER_TMP_SHARE_LONG_COUNT);
+  memset(tmp_longlong, 0, sizeof(longlong) * SPIDER_TMP_SHARE_LONGLONG_COUNT);
+  spider_set_tmp_share_pointer(&tmp_share, (char **)&tmp_connect_info,
+                               tmp_connect_info_length, tmp_long, tmp_longlong);
+  tmp_share.tgt_ports[0] = -1;
+  tmp_share.tgt_ssl_vscs[0] = -1;
+  tmp_share.link_statuses[0] = -1;
+  tmp_share.server_names_lengths[0] = server->server_name_length;
+  if (!(tmp_share.server_names[0] = spider_create_string(
+            server->server_name, server->server_name_length)) ||
+      spider_set_connect_info_default(&tmp_share,
+#ifdef WITH_PARTITION_STORAGE_ENGINE
+                                      NULL, NULL,
+#endif
+                                      NULL) ||
+      spider_create_conn_keys(&tmp_share) ||
+      spider_update_conn_keys(&tmp_share, 0))
+    goto end;
+
+  /* validate idle connections which are not used for a while, one at a
+     time and in place, so that concurrent checkouts still see the rest of
+     the pool instead of opening new connections */
+  time_now = (time_t)time((time_t *)0);
+  stale_before = time_now - spider_param_conn_pool_maintain_interval();
+  while (conn_pool_maintain_init && !*spd_abort_loop &&
+         (conn = spd_connect_pools.mark_conn_to_ping(
+              tmp_share.conn_keys_hash_value[0],
+              (uchar *)tmp_share.conn_keys[0],
+              tmp_share.conn_keys_lengths[0], stale_before))) {
+    broken = conn->server_lost || conn->queued_connect ||
+             conn->db_conn->ping();
+    if (!broken) conn->ping_time = time_now;
+    if (spd_connect_pools.unmark_pinged_conn(conn, broken)) {
+      DBUG_PRINT("info", ("spider free broken idle conn=%p", conn));
+      spider_update_conn_meta_info(conn, SPIDER_CONN_INVALID_STATUS);
+      spider_free_conn(conn);
+    }
+  }
+
+  /* refill connected idle connections */
+  idle = spd_connect_pools.idle_count(tmp_share.conn_keys_hash_value[0],
+                                      (uchar *)tmp_share.conn_keys[0],
+                                      tmp_share.conn_keys_lengths[0]);
+  for (; idle < min_idle && conn_pool_maintain_init && !*spd_abort_loop;
+       idle++) {
+    if (!(conn = spider_create_conn(&tmp_share, NULL, 0, 0,
+                                    SPIDER_CONN_KIND_MYSQL, &error_num)))
+      break;
+    conn->thd = thd;
+    if ((error_num = spider_db_connect(&tmp_share, conn, 0))) {
+      spider_update_conn_meta_info(conn, SPIDER_CONN_INVALID_STATUS);
+      spider_free_conn(conn);
+      break;
+    }
+    conn->queued_connect = FALSE;
+    conn->server_lost = FALSE;
+    /* run the session setup prelude now instead of at the first query */
+    spider_check_and_set_trx_isolation(conn, NULL);
+    spider_check_and_set_autocommit(thd, conn, NULL);
+    spider_check_and_set_sql_log_off(thd, conn, NULL);
+    spider_check_and_set_time_zone(thd, conn, NULL);
+    if ((error_num = spider_db_conn_queue_action(conn))) {
+      spider_update_conn_meta_info(conn, SPIDER_CONN_INVALID_STATUS);
+      spider_free_conn(conn);
+      break;
+    }
+    conn->thd = NULL;
+    conn->ping_time = (time_t)time((time_t *)0);
+    *conn->conn_key = '0';
+    if (spd_connect_pools.put_conn(conn)) {
+      spider_update_conn_meta_info(conn, SPIDER_CONN_INVALID_STATUS);
+      spider_free_conn(conn);
+      break;
+    }
+  }
+
+end:
+  thd->clear_error();
+  spider_free_tmp_share_alloc(&tmp_share);
+  DBUG_VOID_RETURN;
+}
+
+static void *spider_conn_pool_maintain_action(void *arg) {
+  DBUG_ENTER("spider_conn_pool_maintain_action");
+  THD *thd;
+  my_thread_init();
+  if (!(thd = SPIDER_new_THD(next_thread_id()))) {
+    my_thread_end();
+    DBUG_RETURN(NULL);
+  }
+  SPIDER_set_next_thread_id(thd);
+  thd->thread_stack = (char *)&thd;
+  thd->store_globals();
+  thread_safe_decrement32(
+      &thread_count); /* for shutdonw, don't wait this thread */
+
+  /* mysql.servers is loaded after the plugins, wait for the server start
+     and warm the pool up at once instead of after the first interval.
+     walking mysql.servers covers every link: spider_db_connect() refuses
+     a link without a server, and the conn key of a link is its server
+     name, so no other (host, port, user) ever gets a pool entry */
+  while (!mysqld_server_started && conn_pool_maintain_init &&
+         !*spd_abort_loop)
+    sleep(1);
+
+  while (conn_pool_maintain_init && !*spd_abort_loop) {
+    uint min_idle = spider_param_conn_pool_min_idle();
+    if (min_idle) {
+      MEM_ROOT mem_root;
+      List<FOREIGN_SERVER> server_list;
+      FOREIGN_SERVER *server;
+      SPD_INIT_ALLOC_ROOT(&mem_root, 4096, 0, MYF(MY_WME));
+      get_server_by_wrapper(&server_list, &mem_root, SPIDER_DB_WRAPPER_STR);
+      List_iterator_fast<FOREIGN_SERVER> it(server_list);
+      while ((server = it++) && conn_pool_maintain_init && !*spd_abort_loop) {
+        spider_conn_pool_maintain_server(thd, server, min_idle);
+      }
+      server_list.empty();
+      free_root(&mem_root, MYF(0));
+    }
+
+    for (uint i = 0; i < spider_param_conn_pool_maintain_interval() &&
+                     conn_pool_maintain_init && !*spd_abort_loop;
+         i++) {
+      sleep(1);
+    }
+  }
+
+  thread_safe_increment32(&thread_count);
+  delete thd;
+  my_thread_end();
+  DBUG_RETURN(NULL);
+}
+
+int spider_create_conn_pool_maintain_thread() {
+  int error_num;
+  DBUG_ENTER("spider_create_conn_pool_maintain_thread");
+  if (conn_pool_maintain_init) {
+    DBUG_RETURN(0);
+  }
+
+  conn_pool_maintain_init = TRUE;
+#if MYSQL_VERSION_ID < 50500
+  if (pthread_create(&conn_pool_maintain_thread, NULL,
+                     spider_conn_pool_maintain_action, NULL))
+#else
+  if (mysql_thread_create(spd_key_thd_conn_pool_maintain,
+                          &conn_pool_maintain_thread, NULL,
+                          spider_conn_pool_maintain_action, NULL))
+#endif
+  {
+    conn_pool_maintain_init = FALSE;
+    error_num = HA_ERR_OUT_OF_MEM;
+    goto error_thread_create;
+  }
+  DBUG_RETURN(0);
+
+error_thread_create:
+  DBUG_RETURN(error_num);
+}
+
+void spider_free_conn_pool_maintain_thread() {
+  DBUG_ENTER("spider_free_conn_pool_maintain_thread");
+  if (conn_pool_maintain_init) {
+    conn_pool_maintain_init = FALSE;
+    pthread_join(conn_pool_maintain_thread, NULL);
+  }
+  DBUG_VOID_RETURN;
+}
+
 void spider_free_conn_meta(void *meta) {
   DBUG_ENTER("free_spider_conn_meta");
   if (meta) {
@@ -3950,17 +4569,107 @@ MYSQL *spider_mysql_connect(char *tgt_host, char *tgt_username,
   DBUG_RETURN(db_conn);
 }
 
+static int spider_sts_refresh_job_cmp_name(SPIDER_STS_REFRESH_JOB *a,
+                                            SPIDER_STS_REFRESH_JOB *b) {
+  int res;
+  if ((res = memcmp(a->table_name, b->table_name,
+                    MY_MIN(a->db_tb_length, b->db_tb_length))))
+    return res;
+  if (a->db_tb_length != b->db_tb_length)
+    return a->db_tb_length < b->db_tb_length ? -1 : 1;
+  if (a->priority != b->priority) return a->priority > b->priority ? -1 : 1;
+  return 0;
+}
+
+static int spider_sts_refresh_job_cmp_priority(SPIDER_STS_REFRESH_JOB *a,
+                                                SPIDER_STS_REFRESH_JOB *b) {
+  if (a->priority != b->priority) return a->priority > b->priority ? -1 : 1;
+  return 0;
+}
+
+/**
+  Collect the shares whose table status is due for a refresh, one job per
+  local table, most stale and most used first.
+*/
+
+static void spider_get_status_jobs(DYNAMIC_ARRAY *jobs, MEM_ROOT *mem_root,
+                                   time_t cur_time, double modify_interval,
+                                   double interval_least) {
+  SPIDER_SHARE *share;
+  SPIDER_STS_REFRESH_JOB job, *prev_job, *tmp_job;
+  double staleness, max_staleness = 0;
+  uint roop_count, elements;
+  DBUG_ENTER("spider_get_status_jobs");
+  reset_dynamic(jobs);
+  pthread_mutex_lock(&spider_tbl_mutex);
+  for (roop_count = 0; roop_count < spider_open_tables.records; roop_count++) {
+    share = (SPIDER_SHARE *)my_hash_element(&spider_open_tables, roop_count);
+    if (!share || !share->tgt_hosts[0] || !share->tgt_usernames[0] ||
+        !share->tgt_passwords[0] || !share->table_name || !share->tgt_dbs[0] ||
+        !share->tgt_table_names[0])
+      continue;
+    staleness = difftime(cur_time, share->modify_time);
+    if (staleness < modify_interval ||
+        difftime(cur_time, share->pre_modify_time) <= interval_least)
+      continue;
+    if (staleness > max_staleness) max_staleness = staleness;
+    if (!(job.table_name =
+              strmake_root(mem_root, share->table_name_with_version,
+                           share->table_name_with_version_length)))
+      break;
+    job.table_name_length = share->table_name_with_version_length;
+    job.db_tb_length = share->table_name_length;
+    job.priority = staleness * (1 + share->status_access_count);
+    if (insert_dynamic(jobs, (uchar *)&job)) break;
+  }
+  pthread_mutex_unlock(&spider_tbl_mutex);
+  spider_status_max_staleness = (ulonglong)max_staleness;
+
+  /* shares of the same table with different versions refresh only once */
+  my_qsort(dynamic_element(jobs, 0, SPIDER_STS_REFRESH_JOB *), jobs->elements,
+           sizeof(SPIDER_STS_REFRESH_JOB),
+           (qsort_cmp)spider_sts_refresh_job_cmp_name);
+  prev_job = NULL;
+  elements = 0;
+  for (roop_count = 0; roop_count < jobs->elements; roop_count++) {
+    tmp_job = dynamic_element(jobs, roop_count, SPIDER_STS_REFRESH_JOB *);
+    if (prev_job && prev_job->db_tb_length == tmp_job->db_tb_length &&
+        !memcmp(prev_job->table_name, tmp_job->table_name,
+                tmp_job->db_tb_length))
+      continue;
+    prev_job = dynamic_element(jobs, elements, SPIDER_STS_REFRESH_JOB *);
+    if (prev_job != tmp_job) *prev_job = *tmp_job;
+    elements++;
+  }
+  jobs->elements = elements;
+  my_qsort(dynamic_element(jobs, 0, SPIDER_STS_REFRESH_JOB *), jobs->elements,
+           sizeof(SPIDER_STS_REFRESH_JOB),
+           (qsort_cmp)spider_sts_refresh_job_cmp_priority);
+  DBUG_VOID_RETURN;
+}
+
 static void *spider_get_status_action(void *arg) {
   DBUG_ENTER("spider_get_status_action");
 
   SPIDER_SHARE *share;
+  SPIDER_STS_REFRESH_JOB *job;
+  DYNAMIC_ARRAY jobs;
+  MEM_ROOT job_mem_root;
+  uint refresh_pass = 0;
   MYSQL *conn;
   THD *thd;
   my_thread_init();
+  if (SPD_INIT_DYNAMIC_ARRAY2(&jobs, sizeof(SPIDER_STS_REFRESH_JOB), NULL, 64,
+                              64, MYF(MY_WME))) {
+    my_thread_end();
+    DBUG_RETURN(NULL);
+  }
   if (!(thd = SPIDER_new_THD(next_thread_id()))) {
+    delete_dynamic(&jobs);
     my_thread_end();
     DBUG_RETURN(NULL);
   }
+  SPD_INIT_ALLOC_ROOT(&job_mem_root, 4096, 0, MYF(MY_WME));
   SPIDER_set_next_thread_id(thd);
   thd->thread_stack = (char *)&thd;
   thd->store_globals();
@@ -4011,18 +4720,26 @@ static void *spider_get_status_action(void *arg) {
     struct tm *l_time = localtime_r(&to_tm_time, &lt);
     my_hrtime_t current_time = my_hrtime();
     long usec = hrtime_sec_part(current_time);
-    pthread_mutex_lock(&spider_tbl_mutex);
-    share_records = spider_open_tables.records;
-    pthread_mutex_unlock(&spider_tbl_mutex);
+    ulong refresh_limit = spider_param_status_refresh_per_backend();
+    refresh_pass++;
+    free_root(&job_mem_root, MYF(MY_MARK_BLOCKS_FREE));
+    if (spider_param_get_sts_or_crd())
+      spider_get_status_jobs(&jobs, &job_mem_root, (time_t)time((time_t *)0),
+                             modify_interval, interval_least);
+    else
+      reset_dynamic(&jobs);
+    share_records = jobs.elements;
 
     for (ulong i = 0; (i < share_records) && get_status_init;
-         i++) { /* foreach share */
+         i++) { /* foreach job */
 
       if (!spider_param_get_sts_or_crd()) {
         break;
       }
+      job = dynamic_element(&jobs, i, SPIDER_STS_REFRESH_JOB *);
       pthread_mutex_lock(&spider_tbl_mutex);
-      share = (SPIDER_SHARE *)my_hash_element(&spider_open_tables, i);
+      share = (SPIDER_SHARE *)my_hash_search(
+          &spider_open_tables, (uchar *)job->table_name, job->table_name_length);
       if (!share) {
         pthread_mutex_unlock(&spider_tbl_mutex);
         continue;
@@ -4049,21 +4766,36 @@ static void *spider_get_status_action(void *arg) {
              strlen(share->tgt_table_names[0]) + 1);
       port = share->tgt_ports[0];
       pre_modify_time = share->pre_modify_time;
-      share->pre_modify_time = cur_time;
       db_tb_len = share->table_name_length;
       modify_time = share->modify_time;
       pthread_mutex_unlock(&spider_tbl_mutex);
 
-      sts_conn = NULL;
+      key_len = spider_create_sts_conn_key(key, host, port, username, password);
+      sts_conn = (SPIDER_FOR_STS_CONN *)my_hash_search(&spider_for_sts_conns,
+                                                       (uchar *)key, key_len);
+      if (sts_conn && sts_conn->refresh_pass != refresh_pass) {
+        sts_conn->refresh_pass = refresh_pass;
+        sts_conn->refresh_count = 0;
+      }
+      if (refresh_limit && sts_conn &&
+          sts_conn->refresh_count >= refresh_limit) {
+        /* the backend had its share of this pass, stay stale until the next */
+        spider_status_refresh_deferred++;
+        continue;
+      }
       if (difftime(cur_time, modify_time) >= modify_interval &&
           difftime(cur_time, pre_modify_time) >
               interval_least) { /* 1. need to modify table status
                                 2. modify table status at least per 60s
                                 */
-        key_len =
-            spider_create_sts_conn_key(key, host, port, username, password);
-        sts_conn = (SPIDER_FOR_STS_CONN *)my_hash_search(&spider_for_sts_conns,
-                                                         (uchar *)key, key_len);
+        pthread_mutex_lock(&spider_tbl_mutex);
+        if ((share = (SPIDER_SHARE *)my_hash_search(
+                 &spider_open_tables, (uchar *)job->table_name,
+                 job->table_name_length))) {
+          share->pre_modify_time = cur_time;
+          share->status_access_count = 0;
+        }
+        pthread_mutex_unlock(&spider_tbl_mutex);
         if (!sts_conn) { /* not exits, then new and add into hash */
           conn = spider_mysql_connect(host, username, password, port, socket);
           if (conn) {
@@ -4075,6 +4807,9 @@ static void *spider_get_status_action(void *arg) {
         } else { /* can get from hash */
           conn = (MYSQL *)sts_conn->conn;
         }
+        sts_conn->refresh_pass = refresh_pass;
+        sts_conn->refresh_count++;
+        spider_status_refresh_count++;
 
         if (conn) {
           snprintf(query, 256, "%s %s like '%s'", query_head, tgt_db, tgt_tb);
@@ -4178,6 +4913,8 @@ static void *spider_get_status_action(void *arg) {
       sleep(1);
     }
   } /* end while */
+  free_root(&job_mem_root, MYF(0));
+  delete_dynamic(&jobs);
   //   delete thd;
   my_thread_end();
   DBUG_RETURN(NULL);
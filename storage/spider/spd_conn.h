@@ -31,6 +31,10 @@ class SPIDER_CONN_POOL {
   bool put_conn(SPIDER_CONN *conn);
   SPIDER_CONN *get_conn(my_hash_value_type v, uchar *conn, uint key_len);
   SPIDER_CONN *get_conn_by_key(uchar *conn, uint key_len);
+  uint idle_count(my_hash_value_type v, uchar *key, uint key_len);
+  SPIDER_CONN *mark_conn_to_ping(my_hash_value_type v, uchar *key,
+                                 uint key_len, time_t stale_before);
+  bool unmark_pinged_conn(SPIDER_CONN *conn, bool broken);
   void iterate(my_hash_delegate_func iter_func, void *param);
 
   my_hash_value_type calc_hash(const uchar *key, size_t length);
@@ -54,6 +58,10 @@ int spider_reset_conn_setted_parameter(SPIDER_CONN *conn, THD *thd);
 
 int spider_free_conn_alloc(SPIDER_CONN *conn);
 
+bool spider_conn_multiplexed(THD *thd);
+
+void spider_stmt_unbind_conn(SPIDER_TRX *trx, SPIDER_CONN *conn);
+
 void spider_free_conn_from_trx(SPIDER_TRX *trx, SPIDER_CONN *conn, bool another,
                                bool trx_free, int *roop_count);
 
@@ -143,6 +151,8 @@ void spider_bg_all_conn_break(ha_spider *spider);
 
 bool spider_bg_conn_get_job(SPIDER_CONN *conn);
 
+void spider_bg_set_read_ahead_size(ha_spider *spider, longlong size);
+
 int spider_bg_conn_search(ha_spider *spider, int link_idx, int first_link_idx,
                           bool first, bool pre_next, bool discard_result,
                           ulong sql_type = SPIDER_SQL_TYPE_SELECT_SQL);
@@ -219,6 +229,8 @@ void spider_free_ipport_conn(void *info);
 void spider_free_conn_meta(void *);
 void spider_free_conn_recycle_thread(void);
 int spider_create_conn_recycle_thread(void);
+void spider_free_conn_pool_maintain_thread(void);
+int spider_create_conn_pool_maintain_thread(void);
 
 SPIDER_CONN_META_INFO *spider_create_conn_meta(SPIDER_CONN *);
 my_bool spider_add_conn_meta_info(SPIDER_CONN *);
@@ -115,6 +115,8 @@ int spider_db_connect(const SPIDER_SHARE *share, SPIDER_CONN *conn,
         spider_param_net_read_timeout(thd, share->net_read_timeouts[link_idx]);
     conn->net_write_timeout = spider_param_net_write_timeout(
         thd, share->net_write_timeouts[link_idx]);
+    conn->net_compress =
+        spider_param_net_compress(thd, share->net_compresses[link_idx]);
     connect_retry_interval = spider_param_connect_retry_interval(thd);
     if (conn->disable_connect_retry)
       connect_retry_count = 0;
@@ -127,12 +129,15 @@ int spider_db_connect(const SPIDER_SHARE *share, SPIDER_CONN *conn,
         spider_param_net_read_timeout(NULL, share->net_read_timeouts[link_idx]);
     conn->net_write_timeout = spider_param_net_write_timeout(
         NULL, share->net_write_timeouts[link_idx]);
+    conn->net_compress =
+        spider_param_net_compress(NULL, share->net_compresses[link_idx]);
     connect_retry_interval = spider_param_connect_retry_interval(NULL);
     connect_retry_count = spider_param_connect_retry_count(NULL);
   }
   DBUG_PRINT("info", ("spider connect_timeout=%u", conn->connect_timeout));
   DBUG_PRINT("info", ("spider net_read_timeout=%u", conn->net_read_timeout));
   DBUG_PRINT("info", ("spider net_write_timeout=%u", conn->net_write_timeout));
+  DBUG_PRINT("info", ("spider net_compress=%u", conn->net_compress));
   SPD_INIT_ALLOC_ROOT(&mem_root, 128, 0, MYF(MY_WME));
   if (!(server = get_server_by_name(&mem_root, share->server_names[link_idx],
                                     &server_buf))) {
@@ -1867,6 +1872,51 @@ int spider_db_append_key_where(const key_range *start_key,
   DBUG_RETURN(0);
 }
 
+/*
+  Append the whole keys of a point batch as
+  " where (k1 = v1 and k2 = v2) or (k1 = v3 and k2 = v4) ...".
+*/
+int spider_db_append_point_keys_where(spider_string *str,
+                                      SPIDER_POINT_REQ *first,
+                                      ha_spider *spider, uint dbton_id) {
+  SPIDER_SHARE *share = spider->share;
+  KEY *key_info = spider->result_list.key_info;
+  spider_db_share *dbton_share = share->dbton_share[dbton_id];
+  SPIDER_POINT_REQ *req;
+  KEY_PART_INFO *key_part;
+  Field *field;
+  const uchar *ptr;
+  uint roop_count, key_parts = spider_user_defined_key_parts(key_info);
+  DBUG_ENTER("spider_db_append_point_keys_where");
+  if (str->reserve(SPIDER_SQL_WHERE_LEN)) DBUG_RETURN(HA_ERR_OUT_OF_MEM);
+  str->q_append(SPIDER_SQL_WHERE_STR, SPIDER_SQL_WHERE_LEN);
+  for (req = first; req; req = req->next) {
+    if (str->reserve(SPIDER_SQL_OPEN_PAREN_LEN)) DBUG_RETURN(HA_ERR_OUT_OF_MEM);
+    str->q_append(SPIDER_SQL_OPEN_PAREN_STR, SPIDER_SQL_OPEN_PAREN_LEN);
+    for (roop_count = 0, key_part = key_info->key_part, ptr = req->key;
+         roop_count < key_parts;
+         roop_count++, ptr += key_part->store_length, key_part++) {
+      field = key_part->field;
+      if (str->reserve(
+              dbton_share->get_column_name_length(field->field_index) +
+              /* SPIDER_SQL_NAME_QUOTE_LEN */ 2 + SPIDER_SQL_EQUAL_LEN +
+              SPIDER_SQL_AND_LEN))
+        DBUG_RETURN(HA_ERR_OUT_OF_MEM);
+      if (roop_count) str->q_append(SPIDER_SQL_AND_STR, SPIDER_SQL_AND_LEN);
+      dbton_share->append_column_name(str, field->field_index);
+      str->q_append(SPIDER_SQL_EQUAL_STR, SPIDER_SQL_EQUAL_LEN);
+      if (spider_dbton[dbton_id].db_util->append_column_value(
+              spider, str, field, ptr, share->access_charset))
+        DBUG_RETURN(HA_ERR_OUT_OF_MEM);
+    }
+    if (str->reserve(SPIDER_SQL_CLOSE_PAREN_LEN + SPIDER_SQL_OR_LEN))
+      DBUG_RETURN(HA_ERR_OUT_OF_MEM);
+    str->q_append(SPIDER_SQL_CLOSE_PAREN_STR, SPIDER_SQL_CLOSE_PAREN_LEN);
+    if (req->next) str->q_append(SPIDER_SQL_OR_STR, SPIDER_SQL_OR_LEN);
+  }
+  DBUG_RETURN(0);
+}
+
 #ifdef HANDLER_HAS_DIRECT_AGGREGATE
 int spider_db_refetch_for_item_sum_funcs(ha_spider *spider) {
   int error_num;
@@ -2171,6 +2221,63 @@ int spider_db_fetch_row(SPIDER_SHARE *share, Field *field, SPIDER_DB_ROW *row,
   DBUG_RETURN(error_num);
 }
 
+/**
+  Build the list of columns spider_db_fetch_table stores, once per change
+  of the read and write sets instead of testing both bitmaps per row. A
+  scan capturing a config table stores every column.
+*/
+
+static int spider_db_prepare_fetch_plan(ha_spider *spider, TABLE *table) {
+  uint map_bytes = no_bytes_in_map(table->read_set), skip = 0;
+  bool all_columns = spider->config_cache_mode == SPD_CC_CAPTURE;
+  SPIDER_FETCH_PLAN_COLUMN *plan_column;
+  Field **field;
+  DBUG_ENTER("spider_db_prepare_fetch_plan");
+  /* a group by handler fetches into its own temporary table */
+  if (spider->fetch_plan && spider->fetch_plan_table != table) {
+    spider_free(spider_current_trx, spider->fetch_plan, MYF(0));
+    spider->fetch_plan = NULL;
+    spider->fetch_plan_init = FALSE;
+  }
+  if (!spider->fetch_plan) {
+    if (!spider_bulk_malloc(spider_current_trx, 203, MYF(MY_WME),
+                            &spider->fetch_plan,
+                            (uint)(sizeof(SPIDER_FETCH_PLAN_COLUMN) *
+                                   table->s->fields),
+                            &spider->fetch_plan_read_bitmap, map_bytes,
+                            &spider->fetch_plan_write_bitmap, map_bytes,
+                            NullS))
+      DBUG_RETURN(HA_ERR_OUT_OF_MEM);
+    spider->fetch_plan_table = table;
+  } else if (spider->fetch_plan_init &&
+             spider->fetch_plan_all_columns == all_columns &&
+             !memcmp(spider->fetch_plan_read_bitmap, table->read_set->bitmap,
+                     map_bytes) &&
+             !memcmp(spider->fetch_plan_write_bitmap, table->write_set->bitmap,
+                     map_bytes))
+    DBUG_RETURN(0);
+
+  plan_column = spider->fetch_plan;
+  for (field = table->field; *field; field++) {
+    if (all_columns ||
+        bitmap_is_set(table->read_set, (*field)->field_index) |
+            bitmap_is_set(table->write_set, (*field)->field_index)) {
+      plan_column->field = *field;
+      plan_column->skip = skip;
+      plan_column++;
+      skip = 0;
+    }
+    skip++;
+  }
+  spider->fetch_plan_count = (uint)(plan_column - spider->fetch_plan);
+  spider->fetch_plan_tail_skip = skip;
+  memcpy(spider->fetch_plan_read_bitmap, table->read_set->bitmap, map_bytes);
+  memcpy(spider->fetch_plan_write_bitmap, table->write_set->bitmap, map_bytes);
+  spider->fetch_plan_all_columns = all_columns;
+  spider->fetch_plan_init = TRUE;
+  DBUG_RETURN(0);
+}
+
 int spider_db_fetch_table(ha_spider *spider, uchar *buf, TABLE *table,
                           SPIDER_RESULT_LIST *result_list) {
   int error_num;
@@ -2178,7 +2285,8 @@ int spider_db_fetch_table(ha_spider *spider, uchar *buf, TABLE *table,
   my_ptrdiff_t ptr_diff = PTR_BYTE_DIFF(buf, table->record[0]);
   SPIDER_RESULT *current = (SPIDER_RESULT *)result_list->current;
   SPIDER_DB_ROW *row;
-  Field **field;
+  SPIDER_FETCH_PLAN_COLUMN *plan_column, *plan_end;
+  Field *field;
   DBUG_ENTER("spider_db_fetch_table");
   if (result_list->quick_mode == 0) {
     SPIDER_DB_RESULT *result = current->result;
@@ -2250,22 +2358,32 @@ int spider_db_fetch_table(ha_spider *spider, uchar *buf, TABLE *table,
   }
 #endif
 
-  for (field = table->field; *field; field++) {
-    if ((bitmap_is_set(table->read_set, (*field)->field_index) |
-         bitmap_is_set(table->write_set, (*field)->field_index))) {
+  if ((error_num = spider_db_prepare_fetch_plan(spider, table)))
+    DBUG_RETURN(error_num);
+  plan_end = spider->fetch_plan + spider->fetch_plan_count;
 #ifndef DBUG_OFF
-      my_bitmap_map *tmp_map =
-          dbug_tmp_use_all_columns(table, table->write_set);
+  my_bitmap_map *tmp_map = dbug_tmp_use_all_columns(table, table->write_set);
 #endif
-      DBUG_PRINT("info", ("spider bitmap is set %s", (*field)->field_name.str));
-      if ((error_num = spider_db_fetch_row(share, *field, row, ptr_diff)))
-        DBUG_RETURN(error_num);
+  for (plan_column = spider->fetch_plan; plan_column < plan_end;
+       plan_column++) {
+    field = plan_column->field;
+    if (plan_column->skip) row->skip(plan_column->skip);
+    DBUG_PRINT("info", ("spider bitmap is set %s", field->field_name.str));
+    if (ptr_diff)
+      error_num = spider_db_fetch_row(share, field, row, ptr_diff);
+    else
+      error_num = row->store_to_field(field, share->access_charset);
+    if (error_num) {
 #ifndef DBUG_OFF
       dbug_tmp_restore_column_map(table->write_set, tmp_map);
 #endif
+      DBUG_RETURN(error_num);
     }
-    row->next();
   }
+#ifndef DBUG_OFF
+  dbug_tmp_restore_column_map(table->write_set, tmp_map);
+#endif
+  row->skip(spider->fetch_plan_tail_skip);
   table->status = 0;
   DBUG_RETURN(0);
 }
@@ -2474,6 +2592,8 @@ void spider_db_free_one_result_for_start_next(ha_spider *spider) {
   SPIDER_RESULT *result = (SPIDER_RESULT *)result_list->current;
   DBUG_ENTER("spider_db_free_one_result_for_start_next");
   spider_bg_all_conn_break(spider);
+  result_list->bgs_stored = NULL;
+  spider_bg_set_read_ahead_size(spider, 0);
 
   if (result_list->low_mem_read) {
     if (result) {
@@ -2726,6 +2846,8 @@ int spider_db_free_result(ha_spider *spider, bool final) {
     }
   }
   result_list->current = NULL;
+  result_list->bgs_stored = NULL;
+  spider_bg_set_read_ahead_size(spider, 0);
   result_list->record_num = 0;
   DBUG_PRINT("info", ("spider result_list->finish_flg = FALSE"));
   result_list->finish_flg = FALSE;
@@ -3888,6 +4010,7 @@ void spider_db_create_position(ha_spider *spider, SPIDER_POSITION *pos) {
   pos->ft_first = spider->ft_first;
   pos->ft_current = spider->ft_current;
   pos->result = current;
+  pos->config_cache_row = NULL;
   DBUG_VOID_RETURN;
 }
 
@@ -4261,10 +4384,14 @@ int spider_db_show_index(ha_spider *spider, int link_idx, TABLE *table,
 
 ha_rows spider_db_explain_select(key_range *start_key, key_range *end_key,
                                  ha_spider *spider, int link_idx) {
-  DBUG_ENTER("spider_db_explain_select");
-  DBUG_RETURN(0); /* need not this */
-  SPIDER_CONN *conn = spider->spider_get_conn_by_idx(link_idx);
+  SPIDER_CONN *conn;
   ha_rows rows;
+  DBUG_ENTER("spider_db_explain_select");
+  conn = spider->spider_get_conn_by_idx(link_idx);
+  if (!conn) {
+    my_errno = ER_SPIDER_CON_COUNT_ERROR;
+    DBUG_RETURN(HA_POS_ERROR);
+  }
   rows = spider->dbton_handler[conn->dbton_id]->explain_select(
       start_key, end_key, link_idx);
   DBUG_RETURN(rows);
@@ -4313,11 +4440,14 @@ int spider_db_bulk_insert(ha_spider *spider, TABLE *table, bool bulk_end) {
     if ((error_num =
              spider->append_insert_values_sql_part(SPIDER_SQL_TYPE_INSERT_SQL)))
       DBUG_RETURN(error_num);
+    spider->insert_pending_rows++;
   }
 
   if (spider->is_bulk_insert_exec_period(bulk_end)) {
     int roop_count2;
     SPIDER_CONN *conn, *first_insert_conn = NULL;
+    ha_rows pending_rows = spider->insert_pending_rows;
+    spider->insert_pending_rows = 0;
 
     if ((error_num = spider->append_insert_terminator_sql_part(
              SPIDER_SQL_TYPE_INSERT_SQL))) {
@@ -4343,6 +4473,9 @@ int spider_db_bulk_insert(ha_spider *spider, TABLE *table, bool bulk_end) {
         }
         // parallel
         if (spider->result_list.bgs_phase > 0) {
+          /* the bg thread counts the affected rows of the first link */
+          conn->bg_insert_sent_rows =
+              first_insert_link_idx == -1 ? (longlong)pending_rows : -1;
           if (error_num = spider_bg_conn_search(
                   spider, roop_count2, roop_count2, TRUE, FALSE,
                   FALSE /*(roop_count != link_ok)*/,
@@ -4432,6 +4565,15 @@ int spider_db_bulk_insert(ha_spider *spider, TABLE *table, bool bulk_end) {
           }
           DBUG_RETURN(error_num);
         }
+        if (first_insert_link_idx == -1) {
+          /*
+            With "on duplicate key update" or "replace" pushed down, the
+            remote affected rows differ from the rows sent: an updated or
+            replaced row counts 2, a row left unchanged counts 0.
+          */
+          spider->insert_dup_resolved_rows +=
+              (longlong)conn->db_conn->affected_rows() - (longlong)pending_rows;
+        }
         conn->mta_conn_mutex_lock_already = mta_conn_mutex_lock_already_backup;
         conn->mta_conn_mutex_unlock_later = mta_conn_mutex_unlock_later_backup;
         if (!mta_conn_mutex_unlock_later_backup) {
@@ -6924,6 +7066,7 @@ int spider_db_udf_direct_sql_connect(const SPIDER_DIRECT_SQL *direct_sql,
         spider_param_net_read_timeout(thd, direct_sql->net_read_timeout);
     conn->net_write_timeout =
         spider_param_net_write_timeout(thd, direct_sql->net_write_timeout);
+    conn->net_compress = spider_param_net_compress(thd, 0);
     connect_retry_interval = spider_param_connect_retry_interval(thd);
     connect_retry_count = spider_param_connect_retry_count(thd);
   } else {
@@ -6933,6 +7076,7 @@ int spider_db_udf_direct_sql_connect(const SPIDER_DIRECT_SQL *direct_sql,
         spider_param_net_read_timeout(NULL, direct_sql->net_read_timeout);
     conn->net_write_timeout =
         spider_param_net_write_timeout(NULL, direct_sql->net_write_timeout);
+    conn->net_compress = spider_param_net_compress(NULL, 0);
     connect_retry_interval = spider_param_connect_retry_interval(NULL);
     connect_retry_count = spider_param_connect_retry_count(NULL);
   }
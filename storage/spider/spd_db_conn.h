@@ -84,6 +84,8 @@
 #define SPIDER_SQL_FROM_LEN (sizeof(SPIDER_SQL_FROM_STR) - 1)
 #define SPIDER_SQL_WHERE_STR " where "
 #define SPIDER_SQL_WHERE_LEN (sizeof(SPIDER_SQL_WHERE_STR) - 1)
+#define SPIDER_SQL_SAMPLE_SEED 1
+#define SPIDER_SQL_SAMPLE_MAX_LEN 32
 #define SPIDER_SQL_OR_STR " or "
 #define SPIDER_SQL_OR_LEN (sizeof(SPIDER_SQL_OR_STR) - 1)
 #define SPIDER_SQL_ORDER_STR " order by "
@@ -401,6 +403,10 @@ int spider_db_append_key_where_internal(
 int spider_db_append_key_where(const key_range *start_key,
                                const key_range *end_key, ha_spider *spider);
 
+int spider_db_append_point_keys_where(spider_string *str,
+                                      st_spider_point_req *first,
+                                      ha_spider *spider, uint dbton_id);
+
 #ifdef HANDLER_HAS_DIRECT_AGGREGATE
 int spider_db_refetch_for_item_sum_funcs(ha_spider *spider);
 
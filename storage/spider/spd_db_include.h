@@ -215,8 +215,17 @@ enum spider_bulk_upd_start {
 
 enum spider_index_rnd_init { SPD_NONE, SPD_INDEX, SPD_RND };
 
+enum spider_config_cache_mode {
+  SPD_CC_NONE,
+  SPD_CC_CAPTURE,
+  SPD_CC_RND,
+  SPD_CC_INDEX,
+  SPD_CC_POINT
+};
+
 struct st_spider_ft_info;
 struct st_spider_result;
+struct st_spider_point_req;
 typedef struct st_spider_transaction SPIDER_TRX;
 typedef struct st_spider_share SPIDER_SHARE;
 class ha_spider;
@@ -437,7 +446,9 @@ class spider_fields {
   SPIDER_CONN_HOLDER *get_next_conn_holder();
   bool has_conn_holder();
   void clear_conn_holder_from_conn();
+  void detach_conn_holder_from_conn();
   bool check_conn_same_conn(SPIDER_CONN *conn_arg);
+  bool has_same_conn(spider_fields *fields_arg);
   bool remove_conn_if_not_checked();
   void check_support_dbton(uchar *dbton_bitmap);
   void choose_a_conn();
@@ -535,6 +546,7 @@ class spider_db_row {
   virtual int append_escaped_to_str(spider_string *str, uint dbton_id) = 0;
   virtual void first() = 0;
   virtual void next() = 0;
+  virtual void skip(uint count) = 0;
   virtual bool is_null() = 0;
   virtual int val_int() = 0;
   virtual double val_real() = 0;
@@ -609,6 +621,7 @@ class spider_db_conn {
                       int connect_retry_count,
                       longlong connect_retry_interval) = 0;
   virtual int ping() = 0;
+  virtual int reset_session() = 0;
   virtual void bg_disconnect() = 0;
   virtual void disconnect() = 0;
   virtual int set_net_timeout() = 0;
@@ -761,6 +774,8 @@ class spider_db_handler {
   virtual int append_key_where_part(const key_range *start_key,
                                     const key_range *end_key,
                                     ulong sql_type) = 0;
+  virtual int append_point_keys_where_part(st_spider_point_req *first,
+                                           ulong sql_type) = 0;
   virtual int append_is_null_part(ulong sql_type, KEY_PART_INFO *key_part,
                                   const key_range *key, const uchar **ptr,
                                   bool key_eq, bool tgt_final) = 0;
@@ -950,6 +965,13 @@ typedef struct st_spider_dbton {
   spider_db_util *db_util;
 } SPIDER_DBTON;
 
+/* a column of record[0] filled by spider_db_fetch_table */
+typedef struct st_spider_fetch_plan_column {
+  Field *field;
+  /* result columns to step over before this one */
+  uint skip;
+} SPIDER_FETCH_PLAN_COLUMN;
+
 typedef struct st_spider_position {
   SPIDER_DB_ROW *row;
   uint pos_mode;
@@ -964,6 +986,7 @@ typedef struct st_spider_position {
   st_spider_ft_info *ft_current;
   my_off_t tmp_tbl_pos;
   SPIDER_RESULT *result;
+  uchar *config_cache_row;
 } SPIDER_POSITION;
 
 typedef struct st_spider_condition {
@@ -1075,5 +1098,14 @@ typedef struct st_spider_result_list {
   volatile longlong bgs_second_read;
   volatile longlong bgs_split_read;
   volatile SPIDER_RESULT *bgs_current;
+  /* the last batch completely stored by the background search */
+  volatile SPIDER_RESULT *bgs_stored;
+  /* the caller waits for the background search to stop reading ahead */
+  volatile bool bgs_caller_waiting;
+  uint bgs_read_ahead;
+  longlong bgs_read_ahead_limit;
+  /* bytes of this handler counted in trx->bgs_read_ahead_size */
+  longlong bgs_read_ahead_size;
+  SPIDER_TRX *bgs_read_ahead_trx;
   SPIDER_DB_ROW *tmp_pos_row_first;
 } SPIDER_RESULT_LIST;
@@ -56,6 +56,7 @@ extern SPIDER_CONN_POOL spd_connect_pools;
 // extern HASH spider_open_connections;
 extern HASH spider_ipport_conns;
 extern SPIDER_DBTON spider_dbton[SPIDER_DBTON_SIZE];
+extern volatile int64 spider_bulk_update_spills;
 extern const char spider_dig_upper[];
 
 #define SPIDER_SQL_NAME_QUOTE_STR "`"
@@ -138,6 +139,11 @@ static const char *name_quote_str = SPIDER_SQL_NAME_QUOTE_STR;
   sizeof(SPIDER_SQL_SELECT_TABLES_STATUS_STR) - 1
 #define SPIDER_SQL_SHOW_WARNINGS_STR "show warnings"
 #define SPIDER_SQL_SHOW_WARNINGS_LEN sizeof(SPIDER_SQL_SHOW_WARNINGS_STR) - 1
+#define SPIDER_SQL_SELECT_MAX_ALLOWED_PACKET_STR "select @@max_allowed_packet"
+#define SPIDER_SQL_SELECT_MAX_ALLOWED_PACKET_LEN \
+  sizeof(SPIDER_SQL_SELECT_MAX_ALLOWED_PACKET_STR) - 1
+/* packet limit of a backend until its max_allowed_packet is read */
+#define SPIDER_SQL_DEFAULT_MAX_ALLOWED_PACKET 1048576
 
 #define SPIDER_SQL_SHOW_MASTER_STATUS_STR "show master status"
 #define SPIDER_SQL_SHOW_MASTER_STATUS_LEN \
@@ -316,12 +322,14 @@ spider_db_mysql_row::spider_db_mysql_row()
 spider_db_mysql_row::~spider_db_mysql_row() {
   DBUG_ENTER("spider_db_mysql_row::~spider_db_mysql_row");
   DBUG_PRINT("info", ("spider this=%p", this));
-  if (cloned) {
-    spider_free(spider_current_trx, row_first, MYF(0));
-  }
+  /* a clone lives in one block with its data, freed by operator delete */
   DBUG_VOID_RETURN;
 }
 
+void spider_db_mysql_row::operator delete(void *ptr, size_t size) {
+  spider_free(spider_current_trx, ptr, MYF(0));
+}
+
 int spider_db_mysql_row::store_to_field(Field *field,
                                         CHARSET_INFO *access_charset) {
   DBUG_ENTER("spider_db_mysql_row::store_to_field");
@@ -350,8 +358,28 @@ int spider_db_mysql_row::store_to_field(Field *field,
           field->store(*row, *lengths, access_charset);
         }
       }
-    } else
-      field->store(*row, *lengths, access_charset);
+    } else {
+      switch (field->real_type()) {
+        case MYSQL_TYPE_TINY:
+        case MYSQL_TYPE_SHORT:
+        case MYSQL_TYPE_INT24:
+        case MYSQL_TYPE_LONG:
+        case MYSQL_TYPE_LONGLONG: {
+          /* integers come as plain digits, skip the charset aware parser */
+          char *end = *row + *lengths;
+          int error_num;
+          longlong nr = my_strtoll10(*row, &end, &error_num);
+          if (!error_num && end == *row + *lengths) {
+            field->store(nr, **row != '-');
+            break;
+          }
+        }
+        /* fall through */
+        default:
+          field->store(*row, *lengths, access_charset);
+          break;
+      }
+    }
   }
   DBUG_RETURN(0);
 }
@@ -392,6 +420,14 @@ void spider_db_mysql_row::next() {
   DBUG_VOID_RETURN;
 }
 
+void spider_db_mysql_row::skip(uint count) {
+  DBUG_ENTER("spider_db_mysql_row::skip");
+  DBUG_PRINT("info", ("spider this=%p", this));
+  row += count;
+  lengths += count;
+  DBUG_VOID_RETURN;
+}
+
 bool spider_db_mysql_row::is_null() {
   DBUG_ENTER("spider_db_mysql_row::is_null");
   DBUG_PRINT("info", ("spider this=%p", this));
@@ -433,23 +469,26 @@ SPIDER_DB_ROW *spider_db_mysql_row::clone() {
   MYSQL_ROW tmp_row = row_first, ctmp_row;
   ulong *tmp_lengths = lengths_first;
   uint row_size, i;
+  void *clone_ptr;
+  MYSQL_ROW clone_row_ptr;
+  ulong *clone_lengths;
   DBUG_ENTER("spider_db_mysql_row::clone");
   DBUG_PRINT("info", ("spider this=%p", this));
-  if (!(clone_row = new spider_db_mysql_row())) {
-    DBUG_RETURN(NULL);
-  }
   row_size = field_count;
   for (i = 0; i < field_count; i++) {
     row_size += *tmp_lengths;
     tmp_lengths++;
   }
-  if (!spider_bulk_malloc(spider_current_trx, 29, MYF(MY_WME), &clone_row->row,
-                          sizeof(char *) * field_count, &tmp_char, row_size,
-                          &clone_row->lengths, sizeof(ulong) * field_count,
-                          NullS)) {
-    delete clone_row;
+  /* one allocation per clone for the row object and its data */
+  if (!(clone_ptr = spider_bulk_malloc(
+            spider_current_trx, 29, MYF(MY_WME), &clone_ptr,
+            (uint)sizeof(spider_db_mysql_row), &clone_row_ptr,
+            (uint)(sizeof(char *) * field_count), &tmp_char, row_size,
+            &clone_lengths, (uint)(sizeof(ulong) * field_count), NullS)))
     DBUG_RETURN(NULL);
-  }
+  clone_row = new (clone_ptr) spider_db_mysql_row();
+  clone_row->row = clone_row_ptr;
+  clone_row->lengths = clone_lengths;
   memcpy(clone_row->lengths, lengths_first, sizeof(ulong) * field_count);
   tmp_lengths = lengths_first;
   ctmp_row = clone_row->row;
@@ -1509,6 +1548,7 @@ int spider_db_mysql::connect(char *tgt_host, char *tgt_username,
     mysql_options(db_conn, MYSQL_OPT_WRITE_TIMEOUT, &conn->net_write_timeout);
     mysql_options(db_conn, MYSQL_OPT_CONNECT_TIMEOUT, &conn->connect_timeout);
     mysql_options(db_conn, MYSQL_OPT_USE_REMOTE_CONNECTION, NULL);
+    if (conn->net_compress) mysql_options(db_conn, MYSQL_OPT_COMPRESS, NULL);
 
     if (conn->tgt_ssl_ca_length | conn->tgt_ssl_capath_length |
         conn->tgt_ssl_cert_length | conn->tgt_ssl_key_length) {
@@ -1568,6 +1608,8 @@ int spider_db_mysql::connect(char *tgt_host, char *tgt_username,
       break;
     }
   }
+  /* read at the first bulk insert which needs it */
+  conn->max_allowed_packet = 0;
   DBUG_RETURN(0);
 }
 
@@ -1578,6 +1620,38 @@ int spider_db_mysql::ping() {
   DBUG_RETURN(simple_command(db_conn, COM_PING, 0, 0, 0));
 }
 
+/*
+  Read max_allowed_packet of the remote session, once per connection.
+  Failing to read it keeps the default limit.
+*/
+void spider_db_mysql::read_max_allowed_packet() {
+  MYSQL_RES *res;
+  MYSQL_ROW row;
+  DBUG_ENTER("spider_db_mysql::read_max_allowed_packet");
+  DBUG_PRINT("info", ("spider this=%p", this));
+  if (conn->max_allowed_packet) DBUG_VOID_RETURN;
+  conn->max_allowed_packet = SPIDER_SQL_DEFAULT_MAX_ALLOWED_PACKET;
+  if (spider_param_dry_access() || !db_conn) DBUG_VOID_RETURN;
+  if (!mysql_real_query(db_conn, SPIDER_SQL_SELECT_MAX_ALLOWED_PACKET_STR,
+                        SPIDER_SQL_SELECT_MAX_ALLOWED_PACKET_LEN) &&
+      (res = mysql_store_result(db_conn))) {
+    if ((row = mysql_fetch_row(res)) && row[0])
+      conn->max_allowed_packet = strtoul(row[0], NULL, 10);
+    mysql_free_result(res);
+  }
+  DBUG_PRINT("info",
+             ("spider max_allowed_packet=%lu", conn->max_allowed_packet));
+  DBUG_VOID_RETURN;
+}
+
+/* roll back and reset the remote session, like a fresh connection */
+int spider_db_mysql::reset_session() {
+  DBUG_ENTER("spider_db_mysql::reset_session");
+  DBUG_PRINT("info", ("spider this=%p", this));
+  if (spider_param_dry_access()) DBUG_RETURN(0);
+  DBUG_RETURN(simple_command(db_conn, COM_RESET_CONNECTION, 0, 0, 0));
+}
+
 void spider_db_mysql::bg_disconnect() {
   DBUG_ENTER("spider_db_mysql::bg_disconnect");
   DBUG_PRINT("info", ("spider this=%p", this));
@@ -1665,7 +1739,6 @@ int spider_db_mysql::exec_query(const char *query, uint length,
   if (!spider_param_dry_access()) {  // TODO.  if the conn if changed, do dry
                                      // access
     error_num = mysql_real_query(db_conn, query, length);
-    this->conn->last_visited = (time_t)time((time_t *)0);
     spider_update_conn_meta_info(this->conn, SPIDER_CONN_ACTIVE_STATUS);
   }
   if ((error_num && log_result_errors >= 1) ||
@@ -2685,6 +2758,26 @@ int spider_db_mysql_util::append_column_value(ha_spider *spider,
   String *ptr;
   uint length;
   DBUG_ENTER("spider_db_mysql_util::append_column_value");
+  switch (field->type()) {
+    case MYSQL_TYPE_TINY:
+    case MYSQL_TYPE_SHORT:
+    case MYSQL_TYPE_INT24:
+    case MYSQL_TYPE_LONG:
+    case MYSQL_TYPE_LONGLONG:
+      if (!((Field_num *)field)->zerofill) {
+        /* format integers from the record without val_str() */
+        char num_buf[MY_INT64_NUM_DECIMAL_DIGITS + 1];
+        longlong value = new_ptr ? field->val_int(new_ptr) : field->val_int();
+        char *num_end = longlong10_to_str(
+            value, num_buf, ((Field_num *)field)->unsigned_flag ? 10 : -10);
+        if (str->reserve(num_end - num_buf)) DBUG_RETURN(HA_ERR_OUT_OF_MEM);
+        str->q_append(num_buf, num_end - num_buf);
+        DBUG_RETURN(0);
+      }
+      break;
+    default:
+      break;
+  }
   tmp_str.init_calc_mem(113);
 
   if (new_ptr) {
@@ -2809,14 +2902,22 @@ int spider_db_mysql_util::append_column_value(ha_spider *spider,
         (field->type() >= MYSQL_TYPE_ENUM &&
          field->type() <= MYSQL_TYPE_GEOMETRY)) {
       DBUG_PRINT("info", ("spider append_escaped"));
-      char buf2[MAX_FIELD_WIDTH];
-      spider_string tmp_str2(buf2, MAX_FIELD_WIDTH, access_charset);
-      tmp_str2.init_calc_mem(114);
-      tmp_str2.length(0);
-      if (tmp_str2.append(ptr->ptr(), ptr->length(), field->charset()) ||
-          str->reserve(tmp_str2.length() * 2) ||
-          append_escaped_util(str, tmp_str2.get_str()))
-        DBUG_RETURN(HA_ERR_OUT_OF_MEM);
+      uint32 conv_offset;
+      if (!String::needs_conversion(ptr->length(), field->charset(),
+                                    access_charset, &conv_offset)) {
+        /* no conversion, escape straight from the field value */
+        if (str->reserve(ptr->length() * 2) || append_escaped_util(str, ptr))
+          DBUG_RETURN(HA_ERR_OUT_OF_MEM);
+      } else {
+        char buf2[MAX_FIELD_WIDTH];
+        spider_string tmp_str2(buf2, MAX_FIELD_WIDTH, access_charset);
+        tmp_str2.init_calc_mem(114);
+        tmp_str2.length(0);
+        if (tmp_str2.append(ptr->ptr(), ptr->length(), field->charset()) ||
+            str->reserve(tmp_str2.length() * 2) ||
+            append_escaped_util(str, tmp_str2.get_str()))
+          DBUG_RETURN(HA_ERR_OUT_OF_MEM);
+      }
     } else if (str->append(*ptr))
       DBUG_RETURN(HA_ERR_OUT_OF_MEM);
     if (str->reserve(SPIDER_SQL_VALUE_QUOTE_LEN))
@@ -5499,12 +5600,21 @@ spider_mysql_handler::spider_mysql_handler(ha_spider *spider,
       ha_table_name_pos(0),
       insert_pos(0),
       insert_table_name_pos(0),
+      insert_row_max_length(0),
+      insert_buffered_size(0),
+      insert_buffered_query_id(0),
       upd_tmp_tbl(NULL),
+      upd_chunk_first(NULL),
+      upd_chunk_last(NULL),
+      upd_chunk_current(NULL),
+      upd_chunk_size(0),
+      upd_chunk_query_id(0),
       tmp_sql_pos1(0),
       tmp_sql_pos2(0),
       tmp_sql_pos3(0),
       tmp_sql_pos4(0),
       tmp_sql_pos5(0),
+      explain_sql(NULL),
       reading_from_bulk_tmp_table(FALSE),
       union_table_name_pos_first(NULL),
       union_table_name_pos_current(NULL),
@@ -5528,6 +5638,7 @@ spider_mysql_handler::~spider_mysql_handler() {
   if (link_for_hash) {
     spider_free(spider_current_trx, link_for_hash, MYF(0));
   }
+  free_bulk_upd_chunks();
   spider_free_mem_calc(spider_current_trx, mem_calc_id, sizeof(*this));
   DBUG_VOID_RETURN;
 }
@@ -7120,6 +7231,23 @@ int spider_mysql_handler::append_key_where_part(const key_range *start_key,
   DBUG_RETURN(error_num);
 }
 
+int spider_mysql_handler::append_point_keys_where_part(
+    st_spider_point_req *first, ulong sql_type) {
+  int error_num;
+  spider_string *str;
+  DBUG_ENTER("spider_mysql_handler::append_point_keys_where_part");
+  switch (sql_type) {
+    case SPIDER_SQL_TYPE_SELECT_SQL:
+      str = &sql;
+      break;
+    default:
+      DBUG_RETURN(0);
+  }
+  error_num = spider_db_append_point_keys_where(str, first, spider,
+                                                spider_dbton_mysql.dbton_id);
+  DBUG_RETURN(error_num);
+}
+
 int spider_mysql_handler::append_key_where(spider_string *str,
                                            spider_string *str_part,
                                            spider_string *str_part2,
@@ -7159,6 +7287,9 @@ int spider_mysql_handler::append_is_null_part(ulong sql_type,
       str_part = &sql_part;
       str_part2 = &sql_part2;
       break;
+    case SPIDER_SQL_TYPE_OTHER_SQL:
+      str = explain_sql;
+      break;
     default:
       DBUG_RETURN(0);
   }
@@ -7257,6 +7388,9 @@ int spider_mysql_handler::append_where_terminator_part(ulong sql_type,
       str_part = &sql_part;
       str_part2 = &sql_part2;
       break;
+    case SPIDER_SQL_TYPE_OTHER_SQL:
+      str = explain_sql;
+      break;
     default:
       DBUG_RETURN(0);
   }
@@ -7528,6 +7662,21 @@ int spider_mysql_handler::append_condition(spider_string *str,
     }
     tmp_cond = tmp_cond->next;
   }
+  if (str && spider->stats_sample_fraction < 1.0 &&
+      (sql_type & (SPIDER_SQL_TYPE_SELECT_SQL | SPIDER_SQL_TYPE_TMP_SQL))) {
+    /* a fixed seed keeps the sample stable across split reads */
+    char tmp_buf[SPIDER_SQL_SAMPLE_MAX_LEN];
+    uint tmp_length = my_snprintf(tmp_buf, sizeof(tmp_buf),
+                                  "rand(%u) < %.4f", SPIDER_SQL_SAMPLE_SEED,
+                                  spider->stats_sample_fraction);
+    if (str->reserve(SPIDER_SQL_WHERE_LEN + tmp_length))
+      DBUG_RETURN(HA_ERR_OUT_OF_MEM);
+    if (start_where)
+      str->q_append(SPIDER_SQL_WHERE_STR, SPIDER_SQL_WHERE_LEN);
+    else
+      str->q_append(SPIDER_SQL_AND_STR, SPIDER_SQL_AND_LEN);
+    str->q_append(tmp_buf, tmp_length);
+  }
   DBUG_RETURN(0);
 }
 
@@ -7722,6 +7871,9 @@ void spider_mysql_handler::set_order_pos(ulong sql_type) {
     case SPIDER_SQL_TYPE_HANDLER:
       ha_next_pos = ha_sql.length();
       break;
+    case SPIDER_SQL_TYPE_OTHER_SQL:
+      /* explain select has no order by */
+      break;
     default:
       DBUG_ASSERT(0);
       break;
@@ -8558,6 +8710,7 @@ int spider_mysql_handler::append_insert_terminator(spider_string *str) {
 
 int spider_mysql_handler::append_insert_values_part(ulong sql_type) {
   int error_num;
+  uint length;
   spider_string *str;
   DBUG_ENTER("spider_mysql_handler::append_insert_values_part");
   DBUG_PRINT("info", ("spider this=%p", this));
@@ -8568,7 +8721,10 @@ int spider_mysql_handler::append_insert_values_part(ulong sql_type) {
     default:
       DBUG_RETURN(0);
   }
-  error_num = append_insert_values(str);
+  length = str->length();
+  if (!(error_num = append_insert_values(str)) &&
+      str->length() - length > insert_row_max_length)
+    insert_row_max_length = str->length() - length;
   DBUG_RETURN(error_num);
 }
 
@@ -8669,6 +8825,7 @@ int spider_mysql_handler::append_into(spider_string *str) {
     DBUG_RETURN(HA_ERR_OUT_OF_MEM);
   str->q_append(SPIDER_SQL_INTO_STR, SPIDER_SQL_INTO_LEN);
   insert_table_name_pos = str->length();
+  insert_row_max_length = 0;
   append_table_name_with_adjusting(str, first_link_idx,
                                    SPIDER_SQL_TYPE_INSERT_SQL);
   str->q_append(SPIDER_SQL_OPEN_PAREN_STR, SPIDER_SQL_OPEN_PAREN_LEN);
@@ -9132,11 +9289,14 @@ int spider_mysql_handler::append_explain_select(spider_string *str,
     DBUG_RETURN(HA_ERR_OUT_OF_MEM);
   }
   str->q_append(SPIDER_SQL_EXPLAIN_SELECT_STR, SPIDER_SQL_EXPLAIN_SELECT_LEN);
+  explain_sql = str;
   if ((error_num = append_from(str, sql_type, link_idx)) ||
       (error_num = append_key_where(str, NULL, NULL, start_key, end_key,
                                     sql_type, FALSE))) {
+    explain_sql = NULL;
     DBUG_RETURN(HA_ERR_OUT_OF_MEM);
   }
+  explain_sql = NULL;
   DBUG_RETURN(0);
 }
 
@@ -9194,13 +9354,60 @@ bool spider_mysql_handler::is_sole_projection_field(uint16 field_index) {
 }
 
 bool spider_mysql_handler::is_bulk_insert_exec_period(bool bulk_end) {
+  int length = (int)insert_sql.length();
+  ulonglong pending_size, budget;
+  ulong packet_limit = 0;
+  SPIDER_SHARE *share = spider->share;
+  SPIDER_TRX *trx = spider->trx;
+  THD *thd = trx->thd;
+  int roop_count;
   DBUG_ENTER("spider_mysql_handler::is_bulk_insert_exec_period");
   DBUG_PRINT("info", ("spider this=%p", this));
   DBUG_PRINT("info", ("spider insert_sql.length=%u", insert_sql.length()));
   DBUG_PRINT("info", ("spider insert_pos=%d", insert_pos));
   DBUG_PRINT("info", ("spider insert_sql=%s", insert_sql.c_ptr_safe()));
-  if ((bulk_end || (int)insert_sql.length() >= spider->bulk_size) &&
-      (int)insert_sql.length() > insert_pos) {
+  if (length <= insert_pos) DBUG_RETURN(FALSE);
+
+  /*
+    All partitions of a statement share one budget for their buffered
+    rows, so a wide table does not hold bulk_size for every partition.
+  */
+  pending_size = length - insert_pos;
+  if (trx->bulk_insert_query_id != thd->query_id) {
+    trx->bulk_insert_query_id = thd->query_id;
+    trx->bulk_insert_buffered_size = 0;
+  }
+  if (insert_buffered_query_id != thd->query_id) {
+    insert_buffered_query_id = thd->query_id;
+    insert_buffered_size = 0;
+  }
+  trx->bulk_insert_buffered_size =
+      trx->bulk_insert_buffered_size - insert_buffered_size + pending_size;
+  insert_buffered_size = pending_size;
+  budget = spider_param_bulk_insert_buffer_size(thd);
+
+  for (roop_count = 0; roop_count < (int)share->link_count; roop_count++) {
+    SPIDER_CONN *conn = spider->conns[roop_count];
+    ulong conn_limit;
+    if (!conn) continue;
+    conn_limit = conn->max_allowed_packet ? conn->max_allowed_packet
+                                          : SPIDER_SQL_DEFAULT_MAX_ALLOWED_PACKET;
+    if (!packet_limit || conn_limit < packet_limit) packet_limit = conn_limit;
+  }
+  DBUG_PRINT("info", ("spider bulk_insert_buffered_size=%llu",
+                      trx->bulk_insert_buffered_size));
+  DBUG_PRINT("info", ("spider packet_limit=%lu", packet_limit));
+
+  /*
+    Leave room in the packet for the next row and for the tail of
+    "on duplicate key update", which is about as long as the head.
+  */
+  if (bulk_end || length >= spider->bulk_size ||
+      (packet_limit && (ulonglong)length + insert_row_max_length +
+                               insert_pos >= packet_limit) ||
+      (budget && trx->bulk_insert_buffered_size >= budget)) {
+    trx->bulk_insert_buffered_size -= insert_buffered_size;
+    insert_buffered_size = 0;
     DBUG_RETURN(TRUE);
   }
   DBUG_RETURN(FALSE);
@@ -9255,8 +9462,39 @@ bool spider_mysql_handler::support_bulk_update() {
 
 int spider_mysql_handler::bulk_tmp_table_insert() {
   int error_num;
+  THD *thd = spider->trx->thd;
+  TABLE *table = spider->get_table();
   DBUG_ENTER("spider_mysql_handler::bulk_tmp_table_insert");
   DBUG_PRINT("info", ("spider this=%p", this));
+  if (!upd_tmp_tbl) {
+    /*
+      All partitions of a statement share one budget for the statements
+      kept in memory, like the buffered rows of a bulk insert.
+    */
+    SPIDER_TRX *trx = spider->trx;
+    if (trx->bulk_update_query_id != thd->query_id) {
+      trx->bulk_update_query_id = thd->query_id;
+      trx->bulk_update_buffered_size = 0;
+    }
+    DBUG_PRINT("info", ("spider bulk_update_buffered_size=%llu",
+                        trx->bulk_update_buffered_size));
+    if (trx->bulk_update_buffered_size + update_sql.length() <=
+        spider_param_bulk_update_buffer_size(thd)) {
+      if (!(error_num = store_sql_to_bulk_upd_chunk(&update_sql))) {
+        trx->bulk_update_buffered_size += update_sql.length();
+        upd_chunk_query_id = thd->query_id;
+      }
+      DBUG_RETURN(error_num);
+    }
+    DBUG_PRINT("info", ("spider spill to bulk tmp table"));
+    my_atomic_add64(&spider_bulk_update_spills, 1);
+    if (!(upd_tmp_tbl = spider_mk_sys_tmp_table(thd, table, &upd_tmp_tbl_prm,
+                                                "a", update_sql.charset()))) {
+      DBUG_RETURN(HA_ERR_OUT_OF_MEM);
+    }
+    upd_tmp_tbl->file->extra(HA_EXTRA_WRITE_CACHE);
+    upd_tmp_tbl->file->ha_start_bulk_insert((ha_rows)0);
+  }
   error_num = store_sql_to_bulk_tmp_table(&update_sql, upd_tmp_tbl);
   DBUG_RETURN(error_num);
 }
@@ -9275,7 +9513,7 @@ int spider_mysql_handler::bulk_tmp_table_end_bulk_insert() {
   int error_num;
   DBUG_ENTER("spider_mysql_handler::bulk_tmp_table_end_bulk_insert");
   DBUG_PRINT("info", ("spider this=%p", this));
-  if ((error_num = upd_tmp_tbl->file->ha_end_bulk_insert())) {
+  if (upd_tmp_tbl && (error_num = upd_tmp_tbl->file->ha_end_bulk_insert())) {
     DBUG_RETURN(error_num);
   }
   DBUG_RETURN(0);
@@ -9285,10 +9523,13 @@ int spider_mysql_handler::bulk_tmp_table_rnd_init() {
   int error_num;
   DBUG_ENTER("spider_mysql_handler::bulk_tmp_table_rnd_init");
   DBUG_PRINT("info", ("spider this=%p", this));
-  upd_tmp_tbl->file->extra(HA_EXTRA_CACHE);
-  if ((error_num = upd_tmp_tbl->file->ha_rnd_init(TRUE))) {
-    DBUG_RETURN(error_num);
+  if (upd_tmp_tbl) {
+    upd_tmp_tbl->file->extra(HA_EXTRA_CACHE);
+    if ((error_num = upd_tmp_tbl->file->ha_rnd_init(TRUE))) {
+      DBUG_RETURN(error_num);
+    }
   }
+  upd_chunk_current = upd_chunk_first;
   reading_from_bulk_tmp_table = TRUE;
   DBUG_RETURN(0);
 }
@@ -9297,6 +9538,15 @@ int spider_mysql_handler::bulk_tmp_table_rnd_next() {
   int error_num;
   DBUG_ENTER("spider_mysql_handler::bulk_tmp_table_rnd_next");
   DBUG_PRINT("info", ("spider this=%p", this));
+  if (upd_chunk_current) {
+    /* the statements in memory come before the spilled ones */
+    if (insert_sql.copy(upd_chunk_current->sql, upd_chunk_current->sql_length,
+                        update_sql.charset()))
+      DBUG_RETURN(HA_ERR_OUT_OF_MEM);
+    upd_chunk_current = upd_chunk_current->next;
+    DBUG_RETURN(0);
+  }
+  if (!upd_tmp_tbl) DBUG_RETURN(HA_ERR_END_OF_FILE);
 #if defined(MARIADB_BASE_VERSION) && MYSQL_VERSION_ID >= 50200
   error_num = upd_tmp_tbl->file->ha_rnd_next(upd_tmp_tbl->record[0]);
 #else
@@ -9313,7 +9563,8 @@ int spider_mysql_handler::bulk_tmp_table_rnd_end() {
   DBUG_ENTER("spider_mysql_handler::bulk_tmp_table_rnd_end");
   DBUG_PRINT("info", ("spider this=%p", this));
   reading_from_bulk_tmp_table = FALSE;
-  if ((error_num = upd_tmp_tbl->file->ha_rnd_end())) {
+  upd_chunk_current = NULL;
+  if (upd_tmp_tbl && (error_num = upd_tmp_tbl->file->ha_rnd_end())) {
     DBUG_RETURN(error_num);
   }
   DBUG_RETURN(0);
@@ -9331,7 +9582,7 @@ bool spider_mysql_handler::need_copy_for_update(int link_idx) {
 bool spider_mysql_handler::bulk_tmp_table_created() {
   DBUG_ENTER("spider_mysql_handler::bulk_tmp_table_created");
   DBUG_PRINT("info", ("spider this=%p", this));
-  DBUG_RETURN(upd_tmp_tbl);
+  DBUG_RETURN(upd_tmp_tbl || upd_chunk_first);
 }
 
 int spider_mysql_handler::mk_bulk_tmp_table_and_bulk_start() {
@@ -9339,6 +9590,8 @@ int spider_mysql_handler::mk_bulk_tmp_table_and_bulk_start() {
   TABLE *table = spider->get_table();
   DBUG_ENTER("spider_mysql_handler::mk_bulk_tmp_table_and_bulk_start");
   DBUG_PRINT("info", ("spider this=%p", this));
+  /* keep the statements in memory, bulk_tmp_table_insert() spills them */
+  if (spider_param_bulk_update_buffer_size(thd)) DBUG_RETURN(0);
   if (!upd_tmp_tbl) {
     if (!(upd_tmp_tbl = spider_mk_sys_tmp_table(thd, table, &upd_tmp_tbl_prm,
                                                 "a", update_sql.charset()))) {
@@ -9357,6 +9610,48 @@ void spider_mysql_handler::rm_bulk_tmp_table() {
     spider_rm_sys_tmp_table(spider->trx->thd, upd_tmp_tbl, &upd_tmp_tbl_prm);
     upd_tmp_tbl = NULL;
   }
+  /* give the memory back to the budget of the statement */
+  if (upd_chunk_size && spider->trx &&
+      spider->trx->bulk_update_query_id == upd_chunk_query_id)
+    spider->trx->bulk_update_buffered_size -= upd_chunk_size;
+  free_bulk_upd_chunks();
+  DBUG_VOID_RETURN;
+}
+
+int spider_mysql_handler::store_sql_to_bulk_upd_chunk(spider_string *str) {
+  SPIDER_BULK_UPD_CHUNK *chunk;
+  char *sql;
+  DBUG_ENTER("spider_mysql_handler::store_sql_to_bulk_upd_chunk");
+  DBUG_PRINT("info", ("spider this=%p", this));
+  if (!spider_bulk_malloc(spider_current_trx, 256, MYF(MY_WME), &chunk,
+                          sizeof(SPIDER_BULK_UPD_CHUNK), &sql,
+                          str->length(), NullS)) {
+    DBUG_RETURN(HA_ERR_OUT_OF_MEM);
+  }
+  memcpy(sql, str->ptr(), str->length());
+  chunk->sql = sql;
+  chunk->sql_length = str->length();
+  chunk->next = NULL;
+  if (upd_chunk_last)
+    upd_chunk_last->next = chunk;
+  else
+    upd_chunk_first = chunk;
+  upd_chunk_last = chunk;
+  upd_chunk_size += str->length();
+  DBUG_RETURN(0);
+}
+
+void spider_mysql_handler::free_bulk_upd_chunks() {
+  SPIDER_BULK_UPD_CHUNK *chunk;
+  DBUG_ENTER("spider_mysql_handler::free_bulk_upd_chunks");
+  DBUG_PRINT("info", ("spider this=%p", this));
+  while ((chunk = upd_chunk_first)) {
+    upd_chunk_first = chunk->next;
+    spider_free(spider_current_trx, chunk, MYF(0));
+  }
+  upd_chunk_last = NULL;
+  upd_chunk_current = NULL;
+  upd_chunk_size = 0;
   DBUG_VOID_RETURN;
 }
 
@@ -9724,6 +10019,22 @@ int spider_mysql_handler::execute_sql(ulong sql_type, SPIDER_CONN *conn,
       DBUG_PRINT("info", ("spider SPIDER_SQL_TYPE_SELECT_SQL"));
       tgt_sql = exec_insert_sql;
       tgt_length = tgt_sql->length();
+      /*
+        Large bulk inserts are cut at the default packet limit until the
+        one of this backend is known. Ask for it only once they come
+        near, so that other connections don't pay the round trip.
+      */
+      if (!conn->max_allowed_packet &&
+          tgt_length >= SPIDER_SQL_DEFAULT_MAX_ALLOWED_PACKET / 2) {
+        int error_num;
+        bool tmp_mta_conn_mutex_lock_already =
+            conn->mta_conn_mutex_lock_already;
+        conn->mta_conn_mutex_lock_already = TRUE;
+        error_num = spider_db_before_query(conn, need_mon);
+        conn->mta_conn_mutex_lock_already = tmp_mta_conn_mutex_lock_already;
+        if (error_num) DBUG_RETURN(error_num);
+        ((spider_db_mysql *)conn->db_conn)->read_max_allowed_packet();
+      }
       break;
     case SPIDER_SQL_TYPE_UPDATE_SQL:
     case SPIDER_SQL_TYPE_DELETE_SQL:
@@ -10354,10 +10665,11 @@ ha_rows spider_mysql_handler::explain_select(key_range *start_key,
   ha_rows rows;
   DBUG_ENTER("spider_mysql_handler::explain_select");
   if (!conn) {
-    error_num = ER_SPIDER_CON_COUNT_ERROR;
-    DBUG_RETURN(error_num);
+    my_errno = ER_SPIDER_CON_COUNT_ERROR;
+    DBUG_RETURN(HA_POS_ERROR);
   }
   spider_db_handler *dbton_hdl = spider->dbton_handler[conn->dbton_id];
+  str->length(0);
   if ((error_num = dbton_hdl->append_explain_select_part(
            start_key, end_key, SPIDER_SQL_TYPE_OTHER_SQL, link_idx))) {
     my_errno = error_num;
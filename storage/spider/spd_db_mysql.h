@@ -90,11 +90,15 @@ class spider_db_mysql_row : public spider_db_row {
   bool cloned;
   spider_db_mysql_row();
   ~spider_db_mysql_row();
+  static void *operator new(size_t size, void *ptr) { return ptr; }
+  static void operator delete(void *ptr, void *place) {}
+  static void operator delete(void *ptr, size_t size);
   int store_to_field(Field *field, CHARSET_INFO *access_charset);
   int append_to_str(spider_string *str);
   int append_escaped_to_str(spider_string *str, uint dbton_id);
   void first();
   void next();
+  void skip(uint count);
   bool is_null();
   int val_int();
   double val_real();
@@ -173,6 +177,8 @@ class spider_db_mysql : public spider_db_conn {
               long tgt_port, char *tgt_socket, char *server_name,
               int connect_retry_count, longlong connect_retry_interval);
   int ping();
+  int reset_session();
+  void read_max_allowed_packet();
   void bg_disconnect();
   void disconnect();
   int set_net_timeout();
@@ -318,9 +324,19 @@ class spider_mysql_handler : public spider_db_handler {
   spider_string insert_sql;
   int insert_pos;
   int insert_table_name_pos;
+  uint insert_row_max_length;
+  /* bytes counted in the statement budget of insert_buffered_query_id */
+  ulonglong insert_buffered_size;
+  query_id_t insert_buffered_query_id;
   spider_string update_sql;
   TABLE *upd_tmp_tbl;
   TMP_TABLE_PARAM upd_tmp_tbl_prm;
+  /* collected statements kept in memory, spilled to upd_tmp_tbl after */
+  SPIDER_BULK_UPD_CHUNK *upd_chunk_first;
+  SPIDER_BULK_UPD_CHUNK *upd_chunk_last;
+  SPIDER_BULK_UPD_CHUNK *upd_chunk_current;
+  ulonglong upd_chunk_size;
+  query_id_t upd_chunk_query_id;
   spider_string tmp_sql;
   int tmp_sql_pos1; /* drop db nm pos at tmp_table_join */
   int tmp_sql_pos2; /* create db nm pos at tmp_table_join */
@@ -333,6 +349,8 @@ class spider_mysql_handler : public spider_db_handler {
   spider_string *exec_update_sql;
   spider_string *exec_tmp_sql;
   spider_string *exec_ha_sql;
+  /* explain select being built by records_in_range (SPIDER_SQL_TYPE_OTHER_SQL) */
+  spider_string *explain_sql;
   bool reading_from_bulk_tmp_table;
   bool filled_up;
   SPIDER_INT_HLD *union_table_name_pos_first;
@@ -432,6 +450,8 @@ class spider_mysql_handler : public spider_db_handler {
                        spider_string *str_part2, const key_range *start_key,
                        const key_range *end_key, ulong sql_type,
                        bool set_order);
+  int append_point_keys_where_part(st_spider_point_req *first,
+                                   ulong sql_type);
   int append_is_null_part(ulong sql_type, KEY_PART_INFO *key_part,
                           const key_range *key, const uchar **ptr, bool key_eq,
                           bool tgt_final);
@@ -566,6 +586,8 @@ class spider_mysql_handler : public spider_db_handler {
   bool bulk_tmp_table_created();
   int mk_bulk_tmp_table_and_bulk_start();
   void rm_bulk_tmp_table();
+  int store_sql_to_bulk_upd_chunk(spider_string *str);
+  void free_bulk_upd_chunks();
   int store_sql_to_bulk_tmp_table(spider_string *str, TABLE *tmp_table);
   int restore_sql_from_bulk_tmp_table(spider_string *str, TABLE *tmp_table);
   int insert_lock_tables_list(SPIDER_CONN *conn, int link_idx);
@@ -608,6 +608,19 @@ void spider_fields::clear_conn_holder_from_conn() {
   DBUG_VOID_RETURN;
 }
 
+void spider_fields::detach_conn_holder_from_conn() {
+  DBUG_ENTER("spider_fields::detach_conn_holder_from_conn");
+  DBUG_PRINT("info", ("spider this=%p", this));
+  for (current_conn_holder = first_conn_holder; current_conn_holder;
+       current_conn_holder = current_conn_holder->next) {
+    if (current_conn_holder->conn->conn_holder_for_direct_join ==
+        current_conn_holder) {
+      current_conn_holder->conn->conn_holder_for_direct_join = NULL;
+    }
+  }
+  DBUG_VOID_RETURN;
+}
+
 bool spider_fields::check_conn_same_conn(SPIDER_CONN *conn_arg) {
   DBUG_ENTER("spider_fields::check_conn_same_conn");
   DBUG_PRINT("info", ("spider this=%p", this));
@@ -621,6 +634,22 @@ bool spider_fields::check_conn_same_conn(SPIDER_CONN *conn_arg) {
   DBUG_RETURN(FALSE);
 }
 
+bool spider_fields::has_same_conn(spider_fields *fields_arg) {
+  SPIDER_LINK_IDX_CHAIN *link_idx_chain, *link_idx_chain_arg;
+  DBUG_ENTER("spider_fields::has_same_conn");
+  DBUG_PRINT("info", ("spider this=%p", this));
+  for (link_idx_chain = first_link_idx_chain; link_idx_chain;
+       link_idx_chain = link_idx_chain->next) {
+    for (link_idx_chain_arg = fields_arg->first_link_idx_chain;
+         link_idx_chain_arg; link_idx_chain_arg = link_idx_chain_arg->next) {
+      if (link_idx_chain->conn == link_idx_chain_arg->conn) {
+        DBUG_RETURN(TRUE);
+      }
+    }
+  }
+  DBUG_RETURN(FALSE);
+}
+
 bool spider_fields::remove_conn_if_not_checked() {
   SPIDER_CONN_HOLDER *conn_holder;
   bool removed = FALSE;
@@ -754,7 +783,9 @@ void spider_fields::free_conn_holder(SPIDER_CONN_HOLDER *conn_holder_arg) {
       }
     }
   }
-  conn_holder_arg->conn->conn_holder_for_direct_join = NULL;
+  /* another partition's spider_fields may have taken the conn over */
+  if (conn_holder_arg->conn->conn_holder_for_direct_join == conn_holder_arg)
+    conn_holder_arg->conn->conn_holder_for_direct_join = NULL;
   DBUG_PRINT("info", ("spider free conn_holder=%p", conn_holder_arg));
   spider_free(spider_current_trx, conn_holder_arg, MYF(0));
   DBUG_VOID_RETURN;
@@ -1015,7 +1046,10 @@ spider_group_by_handler::spider_group_by_handler(THD *thd_arg, Query *query_arg,
                                                  spider_fields *fields_arg)
     : group_by_handler(thd_arg, spider_hton_ptr),
       query(*query_arg),
-      fields(fields_arg) {
+      fields(fields_arg),
+      parts(NULL),
+      part_count(0),
+      part_pos(0) {
   DBUG_ENTER("spider_group_by_handler::spider_group_by_handler");
   fields->set_pos_to_first_table_holder();
   SPIDER_TABLE_HOLDER *table_holder = fields->get_next_table_holder();
@@ -1024,13 +1058,113 @@ spider_group_by_handler::spider_group_by_handler(THD *thd_arg, Query *query_arg,
   DBUG_VOID_RETURN;
 }
 
+spider_group_by_handler::spider_group_by_handler(THD *thd_arg, Query *query_arg,
+                                                 SPIDER_GBH_PART *parts_arg,
+                                                 uint part_count_arg)
+    : group_by_handler(thd_arg, spider_hton_ptr),
+      query(*query_arg),
+      parts(parts_arg),
+      part_count(part_count_arg),
+      part_pos(0) {
+  uint roop_count;
+  SPIDER_TABLE_HOLDER *table_holder;
+  DBUG_ENTER("spider_group_by_handler::spider_group_by_handler");
+  for (roop_count = 0; roop_count < part_count; ++roop_count) {
+    parts[roop_count].fields->set_pos_to_first_table_holder();
+    table_holder = parts[roop_count].fields->get_next_table_holder();
+    parts[roop_count].spider = table_holder->spider;
+  }
+  set_part(0);
+  trx = spider->trx;
+  DBUG_VOID_RETURN;
+}
+
 spider_group_by_handler::~spider_group_by_handler() {
+  uint roop_count;
   DBUG_ENTER("spider_group_by_handler::~spider_group_by_handler");
-  delete fields;
+  if (parts) {
+    for (roop_count = 0; roop_count < part_count; ++roop_count) {
+      delete parts[roop_count].fields;
+    }
+    spider_free(spider_current_trx, parts, MYF(0));
+  } else {
+    delete fields;
+  }
+  DBUG_VOID_RETURN;
+}
+
+void spider_group_by_handler::set_part(uint part_pos_arg) {
+  DBUG_ENTER("spider_group_by_handler::set_part");
+  DBUG_PRINT("info", ("spider part_pos=%u", part_pos_arg));
+  part_pos = part_pos_arg;
+  fields = parts[part_pos].fields;
+  spider = parts[part_pos].spider;
+  store_error = parts[part_pos].store_error;
+  first = parts[part_pos].first;
+  DBUG_VOID_RETURN;
+}
+
+void spider_group_by_handler::save_part() {
+  DBUG_ENTER("spider_group_by_handler::save_part");
+  parts[part_pos].store_error = store_error;
+  parts[part_pos].first = first;
   DBUG_VOID_RETURN;
 }
 
+bool spider_group_by_handler::parts_have_same_conn() {
+  uint roop_count, roop_count2;
+  DBUG_ENTER("spider_group_by_handler::parts_have_same_conn");
+  for (roop_count = 0; roop_count < part_count; ++roop_count) {
+    for (roop_count2 = roop_count + 1; roop_count2 < part_count;
+         ++roop_count2) {
+      if (parts[roop_count].fields->has_same_conn(parts[roop_count2].fields))
+        DBUG_RETURN(TRUE);
+    }
+  }
+  DBUG_RETURN(FALSE);
+}
+
 int spider_group_by_handler::init_scan() {
+  int error_num;
+  uint roop_count;
+  DBUG_ENTER("spider_group_by_handler::init_scan");
+#ifndef DBUG_OFF
+  Field **field;
+  for (field = table->field; *field; field++) {
+    DBUG_PRINT("info", ("spider field_name=%s", (*field)->field_name.str));
+  }
+#endif
+  if (!parts) {
+    DBUG_RETURN(init_part_scan());
+  }
+
+  /*
+    Each partition runs its own join. If background search is used and no
+    two partitions share a connection, all of them are sent now so that the
+    backends work in parallel. Otherwise a partition is started when the
+    previous one reaches its end.
+  */
+  for (roop_count = 0; roop_count < part_count; ++roop_count) {
+    parts[roop_count].scan_inited = FALSE;
+  }
+  set_part(0);
+  parts[0].scan_inited = TRUE;
+  if ((error_num = init_part_scan())) DBUG_RETURN(error_num);
+  if (part_count > 1 && spider->result_list.bgs_phase > 0 &&
+      !parts_have_same_conn()) {
+    save_part();
+    for (roop_count = 1; roop_count < part_count; ++roop_count) {
+      set_part(roop_count);
+      parts[roop_count].scan_inited = TRUE;
+      if ((error_num = init_part_scan())) DBUG_RETURN(error_num);
+      save_part();
+    }
+    set_part(0);
+  }
+  DBUG_RETURN(0);
+}
+
+int spider_group_by_handler::init_part_scan() {
   int error_num, link_idx;
   uint dbton_id;
   spider_db_handler *dbton_hdl;
@@ -1042,14 +1176,8 @@ int spider_group_by_handler::init_scan() {
   SPIDER_RESULT_LIST *result_list = &spider->result_list;
   SPIDER_LINK_IDX_CHAIN *link_idx_chain;
   SPIDER_LINK_IDX_HOLDER *link_idx_holder;
-  DBUG_ENTER("spider_group_by_handler::init_scan");
+  DBUG_ENTER("spider_group_by_handler::init_part_scan");
   store_error = 0;
-#ifndef DBUG_OFF
-  Field **field;
-  for (field = table->field; *field; field++) {
-    DBUG_PRINT("info", ("spider field_name=%s", (*field)->field_name.str));
-  }
-#endif
 
   if (trx->thd->killed) {
     my_error(ER_QUERY_INTERRUPTED, MYF(0));
@@ -1058,6 +1186,8 @@ int spider_group_by_handler::init_scan() {
 
   spider->use_fields = TRUE;
   spider->fields = fields;
+  /* the temporary table may reuse the address of a freed one */
+  spider->fetch_plan_table = NULL;
 
   spider->check_pre_call(TRUE);
 
@@ -1292,12 +1422,31 @@ int spider_group_by_handler::init_scan() {
 }
 
 int spider_group_by_handler::next_row() {
+  int error_num;
+  DBUG_ENTER("spider_group_by_handler::next_row");
+  if (!parts) {
+    DBUG_RETURN(next_part_row());
+  }
+  while ((error_num = next_part_row()) == HA_ERR_END_OF_FILE &&
+         part_pos + 1 < part_count) {
+    save_part();
+    set_part(part_pos + 1);
+    if (!parts[part_pos].scan_inited) {
+      parts[part_pos].scan_inited = TRUE;
+      if ((error_num = init_part_scan())) DBUG_RETURN(error_num);
+    }
+    table->status = 0;
+  }
+  DBUG_RETURN(error_num);
+}
+
+int spider_group_by_handler::next_part_row() {
   int error_num, link_idx;
   spider_db_handler *dbton_hdl;
   SPIDER_CONN *conn;
   SPIDER_LINK_IDX_CHAIN *link_idx_chain;
   SPIDER_LINK_IDX_HOLDER *link_idx_holder;
-  DBUG_ENTER("spider_group_by_handler::next_row");
+  DBUG_ENTER("spider_group_by_handler::next_part_row");
   if (trx->thd->killed) {
     my_error(ER_QUERY_INTERRUPTED, MYF(0));
     DBUG_RETURN(ER_QUERY_INTERRUPTED);
@@ -1361,8 +1510,214 @@ int spider_group_by_handler::end_scan() {
   DBUG_RETURN(0);
 }
 
-group_by_handler *spider_create_group_by_handler(THD *thd, Query *query) {
-  spider_group_by_handler *group_by_handler;
+static ha_spider *spider_get_direct_join_spider(TABLE_LIST *from,
+                                                int part_id) {
+  DBUG_ENTER("spider_get_direct_join_spider");
+#if defined(PARTITION_HAS_GET_CHILD_HANDLERS)
+  if (from->table->part_info) {
+    partition_info *part_info = from->table->part_info;
+    uint part = part_id >= 0 ? (uint)part_id
+                             : bitmap_get_first_set(&part_info->read_partitions);
+    ha_partition *partition = (ha_partition *)from->table->file;
+    handler **handlers = partition->get_child_handlers();
+    DBUG_RETURN((ha_spider *)handlers[part]);
+  }
+#endif
+  DBUG_RETURN((ha_spider *)from->table->file);
+}
+
+#if defined(PARTITION_HAS_GET_CHILD_HANDLERS)
+static bool spider_part_expr_equal(Item *item1, Item *item2, Field *field1,
+                                   Field *field2) {
+  uint roop_count;
+  DBUG_ENTER("spider_part_expr_equal");
+  item1 = item1->real_item();
+  item2 = item2->real_item();
+  if (item1->type() != item2->type()) DBUG_RETURN(FALSE);
+  switch (item1->type()) {
+    case Item::FIELD_ITEM:
+      DBUG_RETURN(((Item_field *)item1)->field == field1 &&
+                  ((Item_field *)item2)->field == field2);
+    case Item::FUNC_ITEM: {
+      Item_func *func1 = (Item_func *)item1;
+      Item_func *func2 = (Item_func *)item2;
+      if (func1->functype() != func2->functype() ||
+          strcmp(func1->func_name(), func2->func_name()) ||
+          func1->argument_count() != func2->argument_count())
+        DBUG_RETURN(FALSE);
+      for (roop_count = 0; roop_count < func1->argument_count();
+           ++roop_count) {
+        if (!spider_part_expr_equal(func1->arguments()[roop_count],
+                                    func2->arguments()[roop_count], field1,
+                                    field2))
+          DBUG_RETURN(FALSE);
+      }
+      DBUG_RETURN(TRUE);
+    }
+    default:
+      if (!item1->basic_const_item()) DBUG_RETURN(FALSE);
+      DBUG_RETURN(item1->eq(item2, TRUE));
+  }
+}
+
+static bool spider_part_info_equal(partition_info *part_info1,
+                                   partition_info *part_info2) {
+  uint roop_count;
+  DBUG_ENTER("spider_part_info_equal");
+  if (part_info1->part_type != part_info2->part_type ||
+      part_info1->num_parts != part_info2->num_parts ||
+      part_info1->column_list || part_info2->column_list ||
+      part_info1->list_of_part_fields != part_info2->list_of_part_fields ||
+      !bitmap_cmp(&part_info1->read_partitions, &part_info2->read_partitions))
+    DBUG_RETURN(FALSE);
+  /*
+    the join compares the fields with type conversion, values equal that
+    way land in the same partition only if the fields are defined alike
+  */
+  if (!part_info1->part_field_array[0]->eq_def(
+          part_info2->part_field_array[0]))
+    DBUG_RETURN(FALSE);
+  /* KEY partitioning hashes the field value itself */
+  if (!part_info1->list_of_part_fields &&
+      !spider_part_expr_equal(part_info1->part_expr, part_info2->part_expr,
+                              part_info1->part_field_array[0],
+                              part_info2->part_field_array[0]))
+    DBUG_RETURN(FALSE);
+  switch (part_info1->part_type) {
+    case RANGE_PARTITION:
+      for (roop_count = 0; roop_count < part_info1->num_parts; ++roop_count) {
+        if (part_info1->range_int_array[roop_count] !=
+            part_info2->range_int_array[roop_count])
+          DBUG_RETURN(FALSE);
+      }
+      break;
+    case LIST_PARTITION:
+      if (part_info1->num_list_values != part_info2->num_list_values ||
+          part_info1->has_null_part_id != part_info2->has_null_part_id)
+        DBUG_RETURN(FALSE);
+      for (roop_count = 0; roop_count < part_info1->num_list_values;
+           ++roop_count) {
+        if (part_info1->list_array[roop_count].list_value !=
+                part_info2->list_array[roop_count].list_value ||
+            part_info1->list_array[roop_count].partition_id !=
+                part_info2->list_array[roop_count].partition_id)
+          DBUG_RETURN(FALSE);
+      }
+      break;
+    case HASH_PARTITION:
+      if (part_info1->linear_hash_ind != part_info2->linear_hash_ind)
+        DBUG_RETURN(FALSE);
+      break;
+    default:
+      DBUG_RETURN(FALSE);
+  }
+  DBUG_RETURN(TRUE);
+}
+
+static bool spider_cond_equates_fields(Item *cond, Field *field1,
+                                       Field *field2) {
+  DBUG_ENTER("spider_cond_equates_fields");
+  if (!cond) DBUG_RETURN(FALSE);
+  if (cond->type() == Item::COND_ITEM) {
+    if (((Item_cond *)cond)->functype() != Item_func::COND_AND_FUNC)
+      DBUG_RETURN(FALSE);
+    List_iterator_fast<Item> lif(*((Item_cond *)cond)->argument_list());
+    Item *item;
+    while ((item = lif++)) {
+      if (spider_cond_equates_fields(item, field1, field2)) DBUG_RETURN(TRUE);
+    }
+    DBUG_RETURN(FALSE);
+  }
+  if (cond->type() != Item::FUNC_ITEM) DBUG_RETURN(FALSE);
+  Item_func *func = (Item_func *)cond;
+  switch (func->functype()) {
+    case Item_func::EQ_FUNC: {
+      Item *arg1 = func->arguments()[0]->real_item();
+      Item *arg2 = func->arguments()[1]->real_item();
+      if (arg1->type() != Item::FIELD_ITEM || arg2->type() != Item::FIELD_ITEM)
+        DBUG_RETURN(FALSE);
+      Field *tmp_field1 = ((Item_field *)arg1)->field;
+      Field *tmp_field2 = ((Item_field *)arg2)->field;
+      DBUG_RETURN((tmp_field1 == field1 && tmp_field2 == field2) ||
+                  (tmp_field1 == field2 && tmp_field2 == field1));
+    }
+    case Item_func::MULT_EQUAL_FUNC:
+      DBUG_RETURN(((Item_equal *)func)->contains(field1) &&
+                  ((Item_equal *)func)->contains(field2));
+    default:
+      break;
+  }
+  DBUG_RETURN(FALSE);
+}
+
+/*
+  A join that reads several partitions can be run partition by partition
+  only if every partitioned table is split the same way on a column the
+  join condition equates with the first table's one, and nothing in the
+  query needs to see the rows of all partitions at once.
+  Returns the partition_info of the first partitioned table.
+ */
+static partition_info *spider_check_partition_wise_join(THD *thd,
+                                                        Query *query) {
+  TABLE_LIST *from, *tmp_from;
+  partition_info *part_info, *first_part_info = NULL;
+  Field *first_part_field = NULL, *part_field;
+  Item *item;
+  List_iterator_fast<Item> it(*query->select);
+  st_select_lex *select_lex;
+  longlong select_limit, offset_limit;
+  bool equated;
+  DBUG_ENTER("spider_check_partition_wise_join");
+  if (query->distinct || query->group_by || query->order_by || query->having)
+    DBUG_RETURN(NULL);
+  while ((item = it++)) {
+    if (item->with_sum_func) DBUG_RETURN(NULL);
+  }
+
+  from = query->from;
+  do {
+    if (from->table->const_table) continue;
+    if (!(part_info = from->table->part_info)) continue;
+    if (part_info->is_sub_partitioned() || part_info->num_part_fields != 1) {
+      DBUG_PRINT("info", ("spider partition_wise_join needs one partition "
+                          "field without subpartitions"));
+      DBUG_RETURN(NULL);
+    }
+    part_field = part_info->part_field_array[0];
+    if (!first_part_info) {
+      spider_get_select_limit(spider_get_direct_join_spider(from, -1),
+                              &select_lex, &select_limit, &offset_limit);
+      if (select_lex && select_lex->explicit_limit && offset_limit) {
+        DBUG_PRINT("info", ("spider partition_wise_join can't use offset"));
+        DBUG_RETURN(NULL);
+      }
+      first_part_info = part_info;
+      first_part_field = part_field;
+      continue;
+    }
+    if (!spider_part_info_equal(first_part_info, part_info)) {
+      DBUG_PRINT("info", ("spider partitioning is different"));
+      DBUG_RETURN(NULL);
+    }
+    equated = spider_cond_equates_fields(query->where, first_part_field,
+                                         part_field);
+    for (tmp_from = query->from; !equated && tmp_from;
+         tmp_from = tmp_from->next_local) {
+      equated = spider_cond_equates_fields(tmp_from->on_expr, first_part_field,
+                                           part_field);
+    }
+    if (!equated) {
+      DBUG_PRINT("info", ("spider partition fields are not joined"));
+      DBUG_RETURN(NULL);
+    }
+  } while ((from = from->next_local));
+  DBUG_RETURN(first_part_info);
+}
+#endif
+
+static spider_fields *spider_create_fields_for_direct_join(THD *thd,
+                                                           Query *query,
+                                                           int part_id) {
   Item *item;
   TABLE_LIST *from;
   SPIDER_CONN *conn;
@@ -1378,45 +1733,7 @@ group_by_handler *spider_create_group_by_handler(THD *thd, Query *query) {
   spider_fields *fields = NULL, *fields_arg = NULL;
   uint table_idx, dbton_id;
   long tgt_link_status;
-  DBUG_ENTER("spider_create_group_by_handler");
-
-  switch (thd_sql_command(thd)) {
-    case SQLCOM_UPDATE:
-    case SQLCOM_UPDATE_MULTI:
-    case SQLCOM_DELETE:
-    case SQLCOM_DELETE_MULTI:
-      DBUG_PRINT("info",
-                 ("spider update and delete does not support this feature"));
-      DBUG_RETURN(NULL);
-    default:
-      break;
-  }
-
-#ifdef WITH_PARTITION_STORAGE_ENGINE
-  from = query->from;
-  do {
-    DBUG_PRINT("info", ("spider from=%p", from));
-    if (from->table->const_table) continue;
-    if (from->table->part_info) {
-      DBUG_PRINT("info", ("spider partition handler"));
-#if defined(PARTITION_HAS_GET_CHILD_HANDLERS)
-      partition_info *part_info = from->table->part_info;
-      uint bits = bitmap_bits_set(&part_info->read_partitions);
-      DBUG_PRINT("info", ("spider bits=%u", bits));
-      if (bits != 1) {
-        DBUG_PRINT("info", ("spider using multiple partitions is not supported "
-                            "by this feature yet"));
-#else
-      DBUG_PRINT("info",
-                 ("spider partition is not supported by this feature yet"));
-#endif
-        DBUG_RETURN(NULL);
-#if defined(PARTITION_HAS_GET_CHILD_HANDLERS)
-      }
-#endif
-    }
-  } while ((from = from->next_local));
-#endif
+  DBUG_ENTER("spider_create_fields_for_direct_join");
 
   table_idx = 0;
   from = query->from;
@@ -1427,19 +1744,7 @@ group_by_handler *spider_create_group_by_handler(THD *thd, Query *query) {
     /* all tables are const_table */
     DBUG_RETURN(NULL);
   }
-#if defined(PARTITION_HAS_GET_CHILD_HANDLERS)
-  if (from->table->part_info) {
-    partition_info *part_info = from->table->part_info;
-    uint part = bitmap_get_first_set(&part_info->read_partitions);
-    ha_partition *partition = (ha_partition *)from->table->file;
-    handler **handlers = partition->get_child_handlers();
-    spider = (ha_spider *)handlers[part];
-  } else {
-#endif
-    spider = (ha_spider *)from->table->file;
-#if defined(PARTITION_HAS_GET_CHILD_HANDLERS)
-  }
-#endif
+  spider = spider_get_direct_join_spider(from, part_id);
   share = spider->share;
   spider->idx_for_direct_join = table_idx;
   ++table_idx;
@@ -1453,19 +1758,7 @@ group_by_handler *spider_create_group_by_handler(THD *thd, Query *query) {
   }
   while ((from = from->next_local)) {
     if (from->table->const_table) continue;
-#if defined(PARTITION_HAS_GET_CHILD_HANDLERS)
-    if (from->table->part_info) {
-      partition_info *part_info = from->table->part_info;
-      uint part = bitmap_get_first_set(&part_info->read_partitions);
-      ha_partition *partition = (ha_partition *)from->table->file;
-      handler **handlers = partition->get_child_handlers();
-      spider = (ha_spider *)handlers[part];
-    } else {
-#endif
-      spider = (ha_spider *)from->table->file;
-#if defined(PARTITION_HAS_GET_CHILD_HANDLERS)
-    }
-#endif
+    spider = spider_get_direct_join_spider(from, part_id);
     share = spider->share;
     spider->idx_for_direct_join = table_idx;
     ++table_idx;
@@ -1487,19 +1780,7 @@ group_by_handler *spider_create_group_by_handler(THD *thd, Query *query) {
   from = query->from;
   do {
     if (from->table->const_table) continue;
-#if defined(PARTITION_HAS_GET_CHILD_HANDLERS)
-    if (from->table->part_info) {
-      partition_info *part_info = from->table->part_info;
-      uint part = bitmap_get_first_set(&part_info->read_partitions);
-      ha_partition *partition = (ha_partition *)from->table->file;
-      handler **handlers = partition->get_child_handlers();
-      spider = (ha_spider *)handlers[part];
-    } else {
-#endif
-      spider = (ha_spider *)from->table->file;
-#if defined(PARTITION_HAS_GET_CHILD_HANDLERS)
-    }
-#endif
+    spider = spider_get_direct_join_spider(from, part_id);
     share = spider->share;
     if (spider_param_skip_default_condition(thd,
                                             share->skip_default_condition)) {
@@ -1614,19 +1895,7 @@ group_by_handler *spider_create_group_by_handler(THD *thd, Query *query) {
   while (from->table->const_table) {
     from = from->next_local;
   }
-#if defined(PARTITION_HAS_GET_CHILD_HANDLERS)
-  if (from->table->part_info) {
-    partition_info *part_info = from->table->part_info;
-    uint part = bitmap_get_first_set(&part_info->read_partitions);
-    ha_partition *partition = (ha_partition *)from->table->file;
-    handler **handlers = partition->get_child_handlers();
-    spider = (ha_spider *)handlers[part];
-  } else {
-#endif
-    spider = (ha_spider *)from->table->file;
-#if defined(PARTITION_HAS_GET_CHILD_HANDLERS)
-  }
-#endif
+  spider = spider_get_direct_join_spider(from, part_id);
   share = spider->share;
   lock_mode = spider_conn_lock_mode(spider);
   if (lock_mode) {
@@ -1695,19 +1964,7 @@ group_by_handler *spider_create_group_by_handler(THD *thd, Query *query) {
     if (from->table->const_table) continue;
     fields->clear_conn_holder_from_conn();
 
-#if defined(PARTITION_HAS_GET_CHILD_HANDLERS)
-    if (from->table->part_info) {
-      partition_info *part_info = from->table->part_info;
-      uint part = bitmap_get_first_set(&part_info->read_partitions);
-      ha_partition *partition = (ha_partition *)from->table->file;
-      handler **handlers = partition->get_child_handlers();
-      spider = (ha_spider *)handlers[part];
-    } else {
-#endif
-      spider = (ha_spider *)from->table->file;
-#if defined(PARTITION_HAS_GET_CHILD_HANDLERS)
-    }
-#endif
+    spider = spider_get_direct_join_spider(from, part_id);
     share = spider->share;
     if (!fields->add_table(spider)) {
       DBUG_PRINT("info", ("spider can not add a table"));
@@ -1804,12 +2061,105 @@ group_by_handler *spider_create_group_by_handler(THD *thd, Query *query) {
   }
 
   fields->set_first_link_idx();
+  DBUG_RETURN(fields);
+}
 
-  if (!(group_by_handler = new spider_group_by_handler(thd, query, fields))) {
-    DBUG_PRINT("info", ("spider can't create group_by_handler"));
-    delete fields;
-    DBUG_RETURN(NULL);
+group_by_handler *spider_create_group_by_handler(THD *thd, Query *query) {
+  spider_group_by_handler *group_by_handler;
+  TABLE_LIST *from;
+  spider_fields *fields;
+#if defined(PARTITION_HAS_GET_CHILD_HANDLERS)
+  bool partition_wise = FALSE;
+#endif
+  DBUG_ENTER("spider_create_group_by_handler");
+
+  switch (thd_sql_command(thd)) {
+    case SQLCOM_UPDATE:
+    case SQLCOM_UPDATE_MULTI:
+    case SQLCOM_DELETE:
+    case SQLCOM_DELETE_MULTI:
+      DBUG_PRINT("info",
+                 ("spider update and delete does not support this feature"));
+      DBUG_RETURN(NULL);
+    default:
+      break;
+  }
+
+#ifdef WITH_PARTITION_STORAGE_ENGINE
+  from = query->from;
+  do {
+    DBUG_PRINT("info", ("spider from=%p", from));
+    if (from->table->const_table) continue;
+    if (from->table->part_info) {
+      DBUG_PRINT("info", ("spider partition handler"));
+#if defined(PARTITION_HAS_GET_CHILD_HANDLERS)
+      partition_info *part_info = from->table->part_info;
+      uint bits = bitmap_bits_set(&part_info->read_partitions);
+      DBUG_PRINT("info", ("spider bits=%u", bits));
+      if (bits != 1) {
+        if (!spider_param_partition_wise_join(thd)) {
+          DBUG_PRINT("info", ("spider using multiple partitions needs "
+                              "partition_wise_join"));
+          DBUG_RETURN(NULL);
+        }
+        partition_wise = TRUE;
+      }
+#else
+      DBUG_PRINT("info",
+                 ("spider partition is not supported by this feature yet"));
+      DBUG_RETURN(NULL);
+#endif
+    }
+  } while ((from = from->next_local));
+#endif
+
+#if defined(PARTITION_HAS_GET_CHILD_HANDLERS)
+  if (partition_wise) {
+    partition_info *part_info;
+    SPIDER_GBH_PART *parts;
+    uint part_count, part_pos = 0, part;
+    if (!(part_info = spider_check_partition_wise_join(thd, query))) {
+      DBUG_RETURN(NULL);
+    }
+    part_count = bitmap_bits_set(&part_info->read_partitions);
+    if (!(parts = (SPIDER_GBH_PART *)spider_bulk_malloc(
+              spider_current_trx, 248, MYF(MY_WME | MY_ZEROFILL), &parts,
+              (uint)(sizeof(SPIDER_GBH_PART) * part_count), NullS))) {
+      DBUG_RETURN(NULL);
+    }
+    for (part = 0; part < part_info->num_parts; ++part) {
+      if (!bitmap_is_set(&part_info->read_partitions, part)) continue;
+      DBUG_PRINT("info", ("spider create fields for part %u", part));
+      if (!(fields = spider_create_fields_for_direct_join(thd, query, part))) {
+        break;
+      }
+      /* conns may be shared with the fields of the next partition */
+      fields->detach_conn_holder_from_conn();
+      parts[part_pos++].fields = fields;
+    }
+    if (part_pos < part_count ||
+        !(group_by_handler =
+              new spider_group_by_handler(thd, query, parts, part_count))) {
+      DBUG_PRINT("info", ("spider can't create group_by_handler"));
+      while (part_pos) {
+        delete parts[--part_pos].fields;
+      }
+      spider_free(spider_current_trx, parts, MYF(0));
+      DBUG_RETURN(NULL);
+    }
+  } else {
+#endif
+    if (!(fields = spider_create_fields_for_direct_join(thd, query, -1))) {
+      DBUG_RETURN(NULL);
+    }
+    if (!(group_by_handler = new spider_group_by_handler(thd, query, fields))) {
+      DBUG_PRINT("info", ("spider can't create group_by_handler"));
+      delete fields;
+      DBUG_RETURN(NULL);
+    }
+#if defined(PARTITION_HAS_GET_CHILD_HANDLERS)
   }
+#endif
   query->distinct = FALSE;
   query->where = NULL;
   query->group_by = NULL;
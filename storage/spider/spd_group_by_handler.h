@@ -14,6 +14,14 @@
   Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA */
 
 #ifdef SPIDER_HAS_GROUP_BY_HANDLER
+typedef struct st_spider_gbh_part {
+  spider_fields *fields;
+  ha_spider *spider;
+  int store_error;
+  bool first;
+  bool scan_inited;
+} SPIDER_GBH_PART;
+
 class spider_group_by_handler : public group_by_handler {
   Query query;
   spider_fields *fields;
@@ -23,14 +31,25 @@ class spider_group_by_handler : public group_by_handler {
   bool first;
   longlong offset_limit;
   int store_error;
+  /* partition wise join */
+  SPIDER_GBH_PART *parts;
+  uint part_count;
+  uint part_pos;
 
  public:
   spider_group_by_handler(THD *thd_arg, Query *query_arg,
                           spider_fields *fields_arg);
+  spider_group_by_handler(THD *thd_arg, Query *query_arg,
+                          SPIDER_GBH_PART *parts_arg, uint part_count_arg);
   ~spider_group_by_handler();
   int init_scan();
   int next_row();
   int end_scan();
+  void set_part(uint part_pos_arg);
+  void save_part();
+  bool parts_have_same_conn();
+  int init_part_scan();
+  int next_part_row();
 };
 
 group_by_handler *spider_create_group_by_handler(THD *thd, Query *query);
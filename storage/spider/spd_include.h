@@ -211,7 +211,7 @@
 
 #define SPIDER_TMP_SHARE_CHAR_PTR_COUNT 20
 #define SPIDER_TMP_SHARE_UINT_COUNT 17
-#define SPIDER_TMP_SHARE_LONG_COUNT 19
+#define SPIDER_TMP_SHARE_LONG_COUNT 20
 #define SPIDER_TMP_SHARE_LONGLONG_COUNT 3
 
 #define SPIDER_MEM_CALC_LIST_NUM 257
@@ -440,6 +440,9 @@ typedef struct st_spider_conn {
   uint connect_timeout;
   uint net_read_timeout;
   uint net_write_timeout;
+  uint net_compress;
+  /* max_allowed_packet of the remote session, 0 if unknown */
+  ulong max_allowed_packet;
   int error_mode;
   spider_string default_database;
 
@@ -497,6 +500,8 @@ typedef struct st_spider_conn {
   pthread_mutex_t bg_conn_chain_mutex;
   pthread_mutex_t *bg_conn_chain_mutex_ptr;
   volatile void *bg_target;
+  /* rows sent by the bg insert whose affected rows are counted, or -1 */
+  volatile longlong bg_insert_sent_rows;
   volatile int *bg_error_num;
   volatile ulong bg_sql_type;
   pthread_mutex_t bg_job_stack_mutex;
@@ -557,6 +562,11 @@ typedef struct st_spider_conn {
   SPIDER_IP_PORT_CONN *ip_port_conn;
   time_t last_visited;
   ulong current_key_version;
+  /* idle list of the connection pool, newer to older */
+  st_spider_conn *pool_newer;
+  st_spider_conn *pool_older;
+  /* being pinged in place by the pool maintainer, not to be checked out */
+  bool pool_pinging;
 } SPIDER_CONN;
 
 typedef struct st_spider_lgtm_tblhnd_share {
@@ -571,6 +581,31 @@ typedef struct st_spider_lgtm_tblhnd_share {
   ulonglong auto_increment_value;
 } SPIDER_LGTM_TBLHND_SHARE;
 
+typedef struct st_spider_sys_stats_preload {
+  char *table_name;
+  uint table_name_length;
+  bool sts_loaded;
+  ulonglong data_file_length;
+  ulonglong max_data_file_length;
+  ulonglong index_file_length;
+  ha_rows records;
+  ulong mean_rec_length;
+  time_t check_time;
+  time_t create_time;
+  time_t update_time;
+  /* -1 means no row for that key_seq */
+  uint crd_count;
+  longlong *cardinality;
+  /* row of spider_table_status */
+  bool status_loaded;
+  ulonglong status_data_file_length;
+  ulonglong status_max_data_file_length;
+  ulonglong status_index_file_length;
+  ha_rows status_records;
+  ulong status_mean_rec_length;
+  time_t status_modify_time;
+} SPIDER_SYS_STATS_PRELOAD;
+
 #ifdef WITH_PARTITION_STORAGE_ENGINE
 typedef struct st_spider_patition_handler_share {
   uint use_count;
@@ -629,6 +664,9 @@ typedef struct st_spider_patition_share {
 } SPIDER_PARTITION_SHARE;
 #endif
 
+/* slots of the per statement conn_key to SPIDER_CONN binding */
+#define SPIDER_STMT_BIND_SLOTS 16
+
 typedef struct st_spider_transaction {
   bool trx_start;
   bool trx_xa;
@@ -676,12 +714,23 @@ typedef struct st_spider_transaction {
   ulonglong spider_thread_id;
   ulonglong trx_conn_adjustment;
   uint locked_connections;
+  /* connections already resolved by the statement of stmt_bind_query_id */
+  query_id_t stmt_bind_query_id;
+  SPIDER_CONN *stmt_bind_conns[SPIDER_STMT_BIND_SLOTS];
 
   ulonglong direct_update_count;
   ulonglong direct_delete_count;
   ulonglong direct_order_limit_count;
   ulonglong direct_aggregate_count;
   ulonglong parallel_search_count;
+  /* bytes of batches read ahead by the background searches */
+  volatile int64 bgs_read_ahead_size;
+  /* bytes of bulk insert statements buffered by bulk_insert_query_id */
+  query_id_t bulk_insert_query_id;
+  ulonglong bulk_insert_buffered_size;
+  /* bytes of bulk update statements kept in memory by bulk_update_query_id */
+  query_id_t bulk_update_query_id;
+  ulonglong bulk_update_buffered_size;
 
 #ifdef HA_CAN_BULK_ACCESS
   SPIDER_CONN *bulk_access_conn_first;
@@ -718,6 +767,71 @@ typedef struct st_spider_transaction {
   spider_db_handler *tmp_dbton_handler[SPIDER_DBTON_SIZE];
 } SPIDER_TRX;
 
+#define SPIDER_CONFIG_CACHE_MAX_SIZE (64 * 1024 * 1024)
+#define SPIDER_RANGE_ESTIMATE_SIZE 64
+
+/*
+  range estimate read by explain, slots are chosen by range_hash.
+  key holds the start bound then the end bound, flags are key_range flag + 1
+  or 0 without a bound.
+*/
+typedef struct st_spider_range_estimate {
+  uint inx;
+  ha_checksum range_hash;
+  time_t get_time;
+  ha_rows rows;
+  uchar *key;
+  uint key_length;
+  uint start_length;
+  uchar start_flag;
+  uchar end_flag;
+} SPIDER_RANGE_ESTIMATE;
+
+/*
+  proxy-local copy of a config table, rows are stored by reclength.
+  key_rows holds records row pointers per key of the table, sorted by the
+  key for the unique keys lookups are served for.
+*/
+typedef struct st_spider_config_cache {
+  uint ref_count;
+  time_t load_time;
+  ha_rows records;
+  uint reclength;
+  uchar *rows;
+  uchar **key_rows;
+} SPIDER_CONFIG_CACHE;
+
+#define SPIDER_POINT_BATCH_MAX_KEYS 64
+
+/* a primary key lookup waiting in a point batch, owned by its session */
+typedef struct st_spider_point_req {
+  const uchar *key;
+  uchar *buf;
+  bool found;
+  st_spider_point_req *next;
+} SPIDER_POINT_REQ;
+
+/*
+  Primary key lookups of concurrent autocommit reads of one share and link,
+  sent by the first session as one remote query. The batch lives on the
+  stack of that session and is protected by share->mutex.
+*/
+typedef struct st_spider_point_batch {
+  pthread_cond_t cond;
+  TABLE_SHARE *table_share;
+  uint link_idx;
+  uint key_length;
+  MY_BITMAP *read_set;
+  MY_BITMAP *write_set;
+  SPIDER_POINT_REQ *first;
+  SPIDER_POINT_REQ *last;
+  uint req_count;
+  uint waiting;
+  bool closed;
+  bool done;
+  int error_num;
+} SPIDER_POINT_BATCH;
+
 typedef struct st_spider_share {
   char *table_name;
   uint table_name_length;
@@ -823,10 +937,24 @@ typedef struct st_spider_share {
 
   time_t modify_time;
   time_t pre_modify_time;
+  /* info() calls since the last table status refresh, not locked */
+  volatile ulong status_access_count;
 
   longlong static_records_for_status;
   longlong static_mean_rec_length;
 
+  /* for config table cache, protected by mutex */
+  SPIDER_CONFIG_CACHE *config_cache;
+  ulonglong config_cache_version;
+
+  /* for crd_mode 3, protected by crd_mutex */
+  SPIDER_RANGE_ESTIMATE *range_estimates;
+
+  /* point batch gathering lookups, protected by mutex */
+  SPIDER_POINT_BATCH *point_batch;
+  /* sessions in a primary key lookup, atomic */
+  volatile int32 point_lookups;
+
   int bitmap_size;
   spider_string *key_hint;
   CHARSET_INFO *access_charset;
@@ -956,6 +1084,7 @@ typedef struct st_spider_share {
   long *connect_timeouts;
   long *net_read_timeouts;
   long *net_write_timeouts;
+  long *net_compresses;
   long *access_balances;
   long *sql_dbton_ids;
   long *bka_table_name_types;
@@ -1040,6 +1169,7 @@ typedef struct st_spider_share {
   uint connect_timeouts_length;
   uint net_read_timeouts_length;
   uint net_write_timeouts_length;
+  uint net_compresses_length;
   uint access_balances_length;
   uint bka_table_name_types_length;
 
@@ -1286,6 +1416,12 @@ typedef struct st_spider_int_hld {
   st_spider_int_hld *next;
 } SPIDER_INT_HLD;
 
+typedef struct st_spider_bulk_upd_chunk {
+  char *sql;
+  uint sql_length;
+  st_spider_bulk_upd_chunk *next;
+} SPIDER_BULK_UPD_CHUNK;
+
 typedef struct st_spider_item_hld {
   uint tgt_num;
   Item *item;
@@ -1298,6 +1434,15 @@ typedef struct st_spider_item_hld {
 
 char *spider_create_string(const char *str, uint length);
 
+/* a session waiting for a connection to a saturated remote server */
+typedef struct st_spider_conn_waiter {
+  pthread_cond_t cond;
+  SPIDER_CONN *conn; /* connection handed over by the releasing session */
+  bool can_create;   /* a connection was freed, create a new one */
+  bool priority;
+  st_spider_conn_waiter *next;
+} SPIDER_CONN_WAITER;
+
 typedef struct st_spider_ip_port_conn {
   char *key;
   size_t key_len;
@@ -1310,6 +1455,9 @@ typedef struct st_spider_ip_port_conn {
   volatile ulong waiting_count;
   pthread_mutex_t mutex;
   pthread_cond_t cond;
+  /* admission queue, priority waiters ahead of the others, FIFO each */
+  SPIDER_CONN_WAITER *waiter_first;
+  SPIDER_CONN_WAITER *waiter_last;
   ulonglong conn_id; /* each conn has it's own conn_id */
 } SPIDER_IP_PORT_CONN;
 
@@ -1317,8 +1465,19 @@ typedef struct st_spider_sts_for_conn {
   char *key;
   size_t key_len;
   char *conn;
+  /* status refreshes sent during the get status pass refresh_pass */
+  uint refresh_pass;
+  uint refresh_count;
 } SPIDER_FOR_STS_CONN;
 
+typedef struct st_spider_sts_refresh_job {
+  /* table_name_with_version of the share, starts with its table_name */
+  char *table_name;
+  uint table_name_length;
+  uint db_tb_length;
+  double priority;
+} SPIDER_STS_REFRESH_JOB;
+
 #define SPIDER_CONN_IS_INIT(a) ((a->status) & 0x0001)
 #define SPIDER_CONN_IS_INIT2(a) ((a->status) & 0x0010)
 #define SPIDER_CONN_IS_ACTIVE(a) ((a->status) & 0x0100)
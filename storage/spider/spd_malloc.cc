@@ -993,6 +993,94 @@ bool spider_string::append(const char *s, uint32 arg_length,
   DBUG_RETURN(res);
 }
 
+#define SPIDER_WORD_ONES 0x0101010101010101ULL
+#define SPIDER_WORD_HIGHS 0x8080808080808080ULL
+#define SPIDER_WORD_HAS_ZERO(A) \
+  (((A) - SPIDER_WORD_ONES) & ~(A) & SPIDER_WORD_HIGHS)
+#define SPIDER_WORD_HAS_BYTE(A, B) \
+  SPIDER_WORD_HAS_ZERO((A) ^ (SPIDER_WORD_ONES * (uchar)(B)))
+
+static inline char spider_escape_char(char chr) {
+  switch (chr) {
+    case 0:
+      return '0';
+    case '\n':
+      return 'n';
+    case '\r':
+      return 'r';
+    case '\\':
+      return '\\';
+    case '\'':
+      return '\'';
+    case '"':
+      return '"';
+    case '\032':
+      return 'Z';
+  }
+  return 0;
+}
+
+/*
+  Same output as escape_string_for_mysql() without length limit.
+  Runs of 8 bytes that need no escape are found with word operations and
+  copied at once. Multi-byte characters are only examined when a byte
+  has its high bit set, which is enough for ASCII based charsets.
+*/
+static size_t spider_escape_string(CHARSET_INFO *cs, char *to,
+                                   const char *from, size_t length) {
+  const char *to_start = to, *end = from + length, *word_end;
+  bool use_mb_flag;
+  ulonglong word;
+  char escape;
+  int tmp_length;
+  if (!my_charset_is_ascii_based(cs))
+    return escape_string_for_mysql(cs, to, 0, from, length);
+  use_mb_flag = use_mb(cs);
+  while (from < end) {
+    if (end - from >= 8) {
+      memcpy(&word, from, 8);
+      if (!((use_mb_flag ? word & SPIDER_WORD_HIGHS : 0) |
+            SPIDER_WORD_HAS_ZERO(word) | SPIDER_WORD_HAS_BYTE(word, '\n') |
+            SPIDER_WORD_HAS_BYTE(word, '\r') |
+            SPIDER_WORD_HAS_BYTE(word, '\\') |
+            SPIDER_WORD_HAS_BYTE(word, '\'') |
+            SPIDER_WORD_HAS_BYTE(word, '"') |
+            SPIDER_WORD_HAS_BYTE(word, '\032'))) {
+        memcpy(to, from, 8);
+        to += 8;
+        from += 8;
+        continue;
+      }
+      word_end = from + 8;
+    } else
+      word_end = end;
+    while (from < word_end) {
+      if (use_mb_flag && (uchar)*from >= 0x80) {
+        tmp_length = my_charlen(cs, from, end);
+        if (tmp_length > 1) {
+          memcpy(to, from, tmp_length);
+          to += tmp_length;
+          from += tmp_length;
+          continue;
+        }
+        if (tmp_length < 1) {
+          /* bad byte sequence */
+          *to++ = '\\';
+          *to++ = *from++;
+          continue;
+        }
+      }
+      if ((escape = spider_escape_char(*from))) {
+        *to++ = '\\';
+        *to++ = escape;
+        from++;
+      } else
+        *to++ = *from++;
+    }
+  }
+  return (size_t)(to - to_start);
+}
+
 void spider_string::append_escape_string(const char *st, uint len) {
   DBUG_ENTER("spider_string::append_escape_string");
   DBUG_PRINT("info", ("spider this=%p", this));
@@ -1000,8 +1088,8 @@ void spider_string::append_escape_string(const char *st, uint len) {
   DBUG_ASSERT((!current_alloc_mem && !str.is_alloced()) ||
               current_alloc_mem == str.alloced_length());
   str.length(str.length() +
-             escape_string_for_mysql(
-                 str.charset(), (char *)str.ptr() + str.length(), 0, st, len));
+             spider_escape_string(
+                 str.charset(), (char *)str.ptr() + str.length(), st, len));
   DBUG_VOID_RETURN;
 }
 
@@ -43,6 +43,19 @@ extern struct st_maria_plugin spider_i_s_conns_maria;
 
 extern volatile ulonglong spider_mon_table_cache_version;
 extern volatile ulonglong spider_mon_table_cache_version_req;
+extern volatile ulonglong spider_status_refresh_count;
+extern volatile ulonglong spider_status_refresh_deferred;
+extern volatile ulonglong spider_status_max_staleness;
+extern volatile int64 spider_bgs_read_ahead_paused;
+extern volatile int64 spider_conn_waits;
+extern volatile int64 spider_conn_wait_timeouts;
+extern volatile int64 spider_conn_wait_handovers;
+extern volatile int64 spider_conn_wait_time;
+extern volatile int64 spider_conn_wait_histogram[5];
+extern volatile int64 spider_conn_wait_queue_depth;
+extern volatile ulonglong spider_point_batches;
+extern volatile ulonglong spider_point_batch_lookups;
+extern volatile int64 spider_bulk_update_spills;
 
 #ifdef HANDLER_HAS_DIRECT_UPDATE_ROWS
 static int spider_direct_update(THD *thd, SHOW_VAR *var, char *buff) {
@@ -101,6 +114,37 @@ struct st_mysql_show_var spider_status_variables[] = {
      SHOW_LONGLONG},
     {"Spider_mon_table_cache_version_req",
      (char *)&spider_mon_table_cache_version_req, SHOW_LONGLONG},
+    {"Spider_status_refresh", (char *)&spider_status_refresh_count,
+     SHOW_LONGLONG},
+    {"Spider_status_refresh_deferred", (char *)&spider_status_refresh_deferred,
+     SHOW_LONGLONG},
+    {"Spider_status_max_staleness", (char *)&spider_status_max_staleness,
+     SHOW_LONGLONG},
+    {"Spider_bgs_read_ahead_paused", (char *)&spider_bgs_read_ahead_paused,
+     SHOW_LONGLONG},
+    {"Spider_conn_waits", (char *)&spider_conn_waits, SHOW_LONGLONG},
+    {"Spider_conn_wait_timeouts", (char *)&spider_conn_wait_timeouts,
+     SHOW_LONGLONG},
+    {"Spider_conn_wait_handovers", (char *)&spider_conn_wait_handovers,
+     SHOW_LONGLONG},
+    {"Spider_conn_wait_time", (char *)&spider_conn_wait_time, SHOW_LONGLONG},
+    {"Spider_conn_wait_under_1ms", (char *)&spider_conn_wait_histogram[0],
+     SHOW_LONGLONG},
+    {"Spider_conn_wait_under_10ms", (char *)&spider_conn_wait_histogram[1],
+     SHOW_LONGLONG},
+    {"Spider_conn_wait_under_100ms", (char *)&spider_conn_wait_histogram[2],
+     SHOW_LONGLONG},
+    {"Spider_conn_wait_under_1s", (char *)&spider_conn_wait_histogram[3],
+     SHOW_LONGLONG},
+    {"Spider_conn_wait_over_1s", (char *)&spider_conn_wait_histogram[4],
+     SHOW_LONGLONG},
+    {"Spider_conn_wait_queue_depth", (char *)&spider_conn_wait_queue_depth,
+     SHOW_LONGLONG},
+    {"Spider_point_batches", (char *)&spider_point_batches, SHOW_LONGLONG},
+    {"Spider_point_batch_lookups", (char *)&spider_point_batch_lookups,
+     SHOW_LONGLONG},
+    {"Spider_bulk_update_spills", (char *)&spider_bulk_update_spills,
+     SHOW_LONGLONG},
 #ifdef HANDLER_HAS_DIRECT_UPDATE_ROWS
 #ifdef SPIDER_HAS_SHOW_SIMPLE_FUNC
     {"Spider_direct_update", (char *)&spider_direct_update, SHOW_SIMPLE_FUNC},
@@ -261,6 +305,25 @@ bool spider_param_sync_trx_isolation(THD *thd) {
   DBUG_RETURN(THDVAR(thd, sync_trx_isolation));
 }
 
+/*
+  FALSE: connections follow spider_conn_recycle_mode
+  TRUE:  autocommit statements check connections out of the pool and
+         return them at the end of the statement
+ */
+static MYSQL_THDVAR_BOOL(conn_multiplex,                      /* name */
+                         PLUGIN_VAR_OPCMDARG,                 /* opt */
+                         "Share remote connections between "
+                         "autocommit statements of all sessions", /* comment */
+                         NULL,                                /* check */
+                         NULL,                                /* update */
+                         FALSE                                /* def */
+);
+
+bool spider_param_conn_multiplex(THD *thd) {
+  DBUG_ENTER("spider_param_conn_multiplex");
+  DBUG_RETURN(THDVAR(thd, conn_multiplex));
+}
+
 /*
   FALSE: no use
   TRUE:  use
@@ -822,6 +885,28 @@ int spider_param_bulk_size(THD *thd, int bulk_size) {
   DBUG_RETURN(THDVAR(thd, bulk_size) < 0 ? bulk_size : THDVAR(thd, bulk_size));
 }
 
+/*
+  0 :no limit
+  1-:bytes of bulk insert statements buffered by all partitions of one
+     statement before the partition over the budget flushes early
+ */
+static MYSQL_THDVAR_UINT(
+    bulk_insert_buffer_size,                                   /* name */
+    PLUGIN_VAR_RQCMDARG,                                       /* opt */
+    "Memory for bulk insert statements buffered per statement", /* comment */
+    NULL,                                                      /* check */
+    NULL,                                                      /* update */
+    67108864,                                                  /* def */
+    0,                                                         /* min */
+    2147483647,                                                /* max */
+    0                                                          /* blk */
+);
+
+uint spider_param_bulk_insert_buffer_size(THD *thd) {
+  DBUG_ENTER("spider_param_bulk_insert_buffer_size");
+  DBUG_RETURN(THDVAR(thd, bulk_insert_buffer_size));
+}
+
 /*
  -1 :use table parameter
   0 : Send "update" and "delete" statements one by one.
@@ -870,6 +955,28 @@ int spider_param_bulk_update_size(THD *thd, int bulk_update_size) {
                   : THDVAR(thd, bulk_update_size));
 }
 
+/*
+  0 :always collect "update" and "delete" statements in a temporary table
+  1-:bytes of collected statements of all tables of a query kept in memory
+     before spilling the rest to a temporary table (bulk_update_mode = 2)
+ */
+static MYSQL_THDVAR_UINT(
+    bulk_update_buffer_size,                                  /* name */
+    PLUGIN_VAR_RQCMDARG,                                      /* opt */
+    "Memory for collected bulk update statements per query",  /* comment */
+    NULL,                                                     /* check */
+    NULL,                                                     /* update */
+    16777216,                                                 /* def */
+    0,                                                        /* min */
+    2147483647,                                               /* max */
+    0                                                         /* blk */
+);
+
+uint spider_param_bulk_update_buffer_size(THD *thd) {
+  DBUG_ENTER("spider_param_bulk_update_buffer_size");
+  DBUG_RETURN(THDVAR(thd, bulk_update_buffer_size));
+}
+
 /*
  -1 :use table parameter
   0 :off
@@ -1103,6 +1210,31 @@ int spider_param_net_write_timeout(THD *thd, int net_write_timeout) {
   DBUG_RETURN(net_write_timeout);
 }
 
+/*
+ -1 :use table parameter
+  0 :don't compress the protocol to remote server
+  1 :compress the protocol to remote server
+ */
+static MYSQL_THDVAR_INT(
+    net_compress,                                           /* name */
+    PLUGIN_VAR_RQCMDARG,                                    /* opt */
+    "Use the compressed protocol to connect remote server", /* comment */
+    NULL,                                                   /* check */
+    NULL,                                                   /* update */
+    -1,                                                     /* def */
+    -1,                                                     /* min */
+    1,                                                      /* max */
+    0                                                       /* blk */
+);
+
+int spider_param_net_compress(THD *thd, int net_compress) {
+  DBUG_ENTER("spider_param_net_compress");
+  if (thd)
+    DBUG_RETURN(THDVAR(thd, net_compress) == -1 ? net_compress
+                                                 : THDVAR(thd, net_compress));
+  DBUG_RETURN(net_compress);
+}
+
 /*
  -1 :use table parameter
   0 :It acquires it collectively.
@@ -1307,6 +1439,48 @@ longlong spider_param_bgs_second_read(THD *thd, longlong bgs_second_read) {
                                                : THDVAR(thd, bgs_second_read));
 }
 
+/*
+  1-:number of batches read ahead of the batch being consumed
+ */
+static MYSQL_THDVAR_UINT(
+    bgs_read_ahead,                                                /* name */
+    PLUGIN_VAR_RQCMDARG,                                           /* opt */
+    "Number of batches read ahead when background search is used", /* comment */
+    NULL,                                                          /* check */
+    NULL,                                                          /* update */
+    1,                                                             /* def */
+    1,                                                             /* min */
+    64,                                                            /* max */
+    0                                                              /* blk */
+);
+
+uint spider_param_bgs_read_ahead(THD *thd) {
+  DBUG_ENTER("spider_param_bgs_read_ahead");
+  DBUG_RETURN(THDVAR(thd, bgs_read_ahead));
+}
+
+/*
+  0 :batches are read ahead one at a time only
+  1-:bytes of batches read ahead a session may hold
+ */
+static MYSQL_THDVAR_LONGLONG(
+    bgs_read_ahead_size, /* name */
+    PLUGIN_VAR_RQCMDARG, /* opt */
+    "Memory size of batches a session may read ahead when background "
+    "search is used",      /* comment */
+    NULL,                  /* check */
+    NULL,                  /* update */
+    67108864,              /* def */
+    0,                     /* min */
+    9223372036854775807LL, /* max */
+    0                      /* blk */
+);
+
+longlong spider_param_bgs_read_ahead_size(THD *thd) {
+  DBUG_ENTER("spider_param_bgs_read_ahead_size");
+  DBUG_RETURN(THDVAR(thd, bgs_read_ahead_size));
+}
+
 /*
  -1 :use table parameter
   0 :records is gotten usually
@@ -1397,6 +1571,50 @@ int spider_param_crd_mode(THD *thd, int crd_mode) {
   DBUG_RETURN(THDVAR(thd, crd_mode) <= 0 ? crd_mode : THDVAR(thd, crd_mode));
 }
 
+/*
+  0    :ask the remote server on every records_in_range call
+  1 or more :seconds a range estimate from crd_mode 3 is reused
+ */
+static uint spider_crd_explain_cache_interval;
+static MYSQL_SYSVAR_UINT(
+    crd_explain_cache_interval, spider_crd_explain_cache_interval,
+    PLUGIN_VAR_RQCMDARG,
+    "the number of seconds a range estimate read by explain (crd_mode 3) "
+    "is reused for the same index and bounds. Default 0, mean never reuse",
+    NULL, NULL, 0, /* def */
+    0,             /* min */
+    86400,         /* max */
+    0              /* blk */
+);
+
+uint spider_param_crd_explain_cache_interval() {
+  DBUG_ENTER("spider_param_crd_explain_cache_interval");
+  DBUG_RETURN(spider_crd_explain_cache_interval);
+}
+
+/*
+  1-99 :percentage of remote rows read by analyze table for
+        engine-independent statistics
+  100  :read every row
+ */
+static MYSQL_THDVAR_UINT(
+    analyze_sample_percent,                                    /* name */
+    PLUGIN_VAR_RQCMDARG,                                       /* opt */
+    "Percentage of remote rows sampled by analyze table when it collects "
+    "engine-independent statistics",                           /* comment */
+    NULL,                                                      /* check */
+    NULL,                                                      /* update */
+    100,                                                       /* def */
+    1,                                                         /* min */
+    100,                                                       /* max */
+    0                                                          /* blk */
+);
+
+uint spider_param_analyze_sample_percent(THD *thd) {
+  DBUG_ENTER("spider_param_analyze_sample_percent");
+  DBUG_RETURN(THDVAR(thd, analyze_sample_percent));
+}
+
 #ifdef WITH_PARTITION_STORAGE_ENGINE
 /*
  -1 :use table parameter
@@ -2128,6 +2346,24 @@ int spider_param_bka_mode(THD *thd, int bka_mode) {
   DBUG_RETURN(THDVAR(thd, bka_mode) == -1 ? bka_mode : THDVAR(thd, bka_mode));
 }
 
+/*
+  FALSE: BKA probes of a join are sent to the partitions one by one
+  TRUE:  BKA probes of a join are sent to all partitions in parallel
+ */
+static MYSQL_THDVAR_BOOL(
+    bka_parallel_search,                                   /* name */
+    PLUGIN_VAR_OPCMDARG,                                   /* opt */
+    "Send BKA probes of a join to partitions in parallel", /* comment */
+    NULL,                                                  /* check */
+    NULL,                                                  /* update */
+    FALSE                                                  /* def */
+);
+
+bool spider_param_bka_parallel_search(THD *thd) {
+  DBUG_ENTER("spider_param_bka_parallel_search");
+  DBUG_RETURN(THDVAR(thd, bka_parallel_search));
+}
+
 static int spider_udf_ct_bulk_insert_interval = 10;
 /*
  -1         : The UDF parameter is adopted.
@@ -2308,6 +2544,24 @@ longlong spider_param_direct_order_limit(THD *thd,
                   : THDVAR(thd, direct_order_limit));
 }
 
+/*
+  FALSE: push down joins reading a single partition only
+  TRUE:  also push down joins of co-partitioned tables partition by partition
+ */
+static MYSQL_THDVAR_BOOL(
+    partition_wise_join,                                       /* name */
+    PLUGIN_VAR_OPCMDARG,                                       /* opt */
+    "Push down joins of co-partitioned tables per partition", /* comment */
+    NULL,                                                      /* check */
+    NULL,                                                      /* update */
+    FALSE                                                      /* def */
+);
+
+bool spider_param_partition_wise_join(THD *thd) {
+  DBUG_ENTER("spider_param_partition_wise_join");
+  DBUG_RETURN(THDVAR(thd, partition_wise_join));
+}
+
 /*
  -1 :use table parameter
   0 :writable
@@ -2527,6 +2781,111 @@ uint spider_param_conn_wait_timeout() {
   DBUG_RETURN(spider_conn_wait_timeout);
 }
 
+/*
+  0 :wait for a remote connection in arrival order
+  1 :wait ahead of the sessions with 0, for short transactions
+ */
+static MYSQL_THDVAR_UINT(
+    conn_wait_priority,                                            /* name */
+    PLUGIN_VAR_RQCMDARG,                                           /* opt */
+    "Priority class of the session waiting for a remote connection", /* comment */
+    NULL,                                                          /* check */
+    NULL,                                                          /* update */
+    0,                                                             /* def */
+    0,                                                             /* min */
+    1,                                                             /* max */
+    0                                                              /* blk */
+);
+
+uint spider_param_conn_wait_priority(THD *thd) {
+  DBUG_ENTER("spider_param_conn_wait_priority");
+  DBUG_RETURN(THDVAR(thd, conn_wait_priority));
+}
+
+/*
+  0    :disable pre-warming of the connection pool
+  1 or more :number of idle connections kept per remote server
+ */
+static uint spider_conn_pool_min_idle;
+static MYSQL_SYSVAR_UINT(
+    conn_pool_min_idle, spider_conn_pool_min_idle, PLUGIN_VAR_RQCMDARG,
+    "the number of connected idle connections the background maintainer "
+    "keeps in the connection pool for each remote server. Only the "
+    "servers of mysql.servers with the mysql wrapper are warmed up, "
+    "which are all the servers spider tables can link to. Default 0, "
+    "mean disable the maintainer",
+    NULL, NULL, 0, /* def */
+    0,             /* min */
+    1000,          /* max */
+    0              /* blk */
+);
+
+uint spider_param_conn_pool_min_idle() {
+  DBUG_ENTER("spider_param_conn_pool_min_idle");
+  DBUG_RETURN(spider_conn_pool_min_idle);
+}
+
+static uint spider_conn_pool_maintain_interval;
+static MYSQL_SYSVAR_UINT(
+    conn_pool_maintain_interval, spider_conn_pool_maintain_interval,
+    PLUGIN_VAR_RQCMDARG,
+    "the interval in seconds at which the background maintainer validates "
+    "and refills idle connections in the connection pool",
+    NULL, NULL, 10, /* def */
+    1,              /* min */
+    3600,           /* max */
+    0               /* blk */
+);
+
+uint spider_param_conn_pool_maintain_interval() {
+  DBUG_ENTER("spider_param_conn_pool_maintain_interval");
+  DBUG_RETURN(spider_conn_pool_maintain_interval);
+}
+
+/*
+  0    :disable the proxy-local cache of config tables
+  1 or more :seconds a cached copy of a config table is served
+ */
+static uint spider_config_table_cache_interval;
+static MYSQL_SYSVAR_UINT(
+    config_table_cache_interval, spider_config_table_cache_interval,
+    PLUGIN_VAR_RQCMDARG,
+    "the number of seconds a proxy-local copy of a table with "
+    "config_table \"true\" is served before it is reloaded from the "
+    "remote server. Default 0, mean always read the remote server",
+    NULL, NULL, 0, /* def */
+    0,             /* min */
+    86400,         /* max */
+    0              /* blk */
+);
+
+uint spider_param_config_table_cache_interval() {
+  DBUG_ENTER("spider_param_config_table_cache_interval");
+  DBUG_RETURN(spider_config_table_cache_interval);
+}
+
+/*
+  0    :send every primary key lookup on its own
+  1 or more :microseconds an autocommit primary key lookup waits for
+             lookups of other sessions to send them as one remote query
+ */
+static MYSQL_THDVAR_UINT(
+    point_batch_window,                                           /* name */
+    PLUGIN_VAR_RQCMDARG,                                          /* opt */
+    "Microseconds to gather primary key lookups of other sessions", /* comment */
+    NULL,                                                         /* check */
+    NULL,                                                         /* update */
+    0,                                                            /* def */
+    0,                                                            /* min */
+    100000,                                                       /* max */
+    0                                                             /* blk */
+);
+
+uint spider_param_point_batch_window(THD *thd) {
+  DBUG_ENTER("spider_param_point_batch_window");
+  DBUG_RETURN(THDVAR(thd, point_batch_window));
+}
+
 /* append primary key first as where condition when not direct update*/
 static my_bool spider_update_with_primary_key_first;
 static MYSQL_SYSVAR_BOOL(update_with_primary_key_first,
@@ -2768,6 +3127,43 @@ int spider_param_load_crd_at_startup(int load_crd_at_startup) {
                                                : spider_load_crd_at_startup);
 }
 
+/*
+  FALSE: read spider_table_sts/crd/status per table
+  TRUE:  read all of spider_table_sts/crd/status in one pass at first use
+ */
+static my_bool spider_preload_sts_crd;
+static MYSQL_SYSVAR_BOOL(preload_sts_crd, spider_preload_sts_crd,
+                         PLUGIN_VAR_OPCMDARG | PLUGIN_VAR_READONLY,
+                         "Load sts/crd/status of all tables from system "
+                         "tables in one pass",
+                         NULL, NULL, FALSE);
+
+my_bool spider_param_preload_sts_crd() {
+  DBUG_ENTER("spider_param_preload_sts_crd");
+  DBUG_RETURN(spider_preload_sts_crd);
+}
+
+static uint spider_status_refresh_per_backend;
+/*
+  0  : no limit
+  1-: table status refreshes per backend in one get status pass
+ */
+static MYSQL_SYSVAR_UINT(status_refresh_per_backend,
+                         spider_status_refresh_per_backend,
+                         PLUGIN_VAR_RQCMDARG,
+                         "Max table status refreshes sent to one backend in "
+                         "one pass of the get status thread",
+                         NULL, NULL, 0, /* def */
+                         0,             /* min */
+                         4294967295U,   /* max */
+                         0              /* blk */
+);
+
+uint spider_param_status_refresh_per_backend() {
+  DBUG_ENTER("spider_param_status_refresh_per_backend");
+  DBUG_RETURN(spider_status_refresh_per_backend);
+}
+
 static uint spider_table_sts_thread_count = 10;
 /*
   1-: thread count
@@ -2808,6 +3204,7 @@ static struct st_mysql_sys_var *spider_system_variables[] = {
     MYSQL_SYSVAR(conn_recycle_mode),
     MYSQL_SYSVAR(conn_recycle_strict),
     MYSQL_SYSVAR(sync_trx_isolation),
+    MYSQL_SYSVAR(conn_multiplex),
     MYSQL_SYSVAR(use_consistent_snapshot),
     MYSQL_SYSVAR(internal_xa_snapshot),
     MYSQL_SYSVAR(force_commit),
@@ -2831,8 +3228,10 @@ static struct st_mysql_sys_var *spider_system_variables[] = {
     MYSQL_SYSVAR(use_default_database),
     MYSQL_SYSVAR(internal_sql_log_off),
     MYSQL_SYSVAR(bulk_size),
+    MYSQL_SYSVAR(bulk_insert_buffer_size),
     MYSQL_SYSVAR(bulk_update_mode),
     MYSQL_SYSVAR(bulk_update_size),
+    MYSQL_SYSVAR(bulk_update_buffer_size),
     MYSQL_SYSVAR(internal_optimize),
     MYSQL_SYSVAR(internal_optimize_local),
     MYSQL_SYSVAR(use_flash_logs),
@@ -2844,6 +3243,7 @@ static struct st_mysql_sys_var *spider_system_variables[] = {
     MYSQL_SYSVAR(connect_timeout),
     MYSQL_SYSVAR(net_read_timeout),
     MYSQL_SYSVAR(net_write_timeout),
+    MYSQL_SYSVAR(net_compress),
     MYSQL_SYSVAR(quick_mode),
     MYSQL_SYSVAR(quick_page_size),
     MYSQL_SYSVAR(low_mem_read),
@@ -2852,11 +3252,15 @@ static struct st_mysql_sys_var *spider_system_variables[] = {
     MYSQL_SYSVAR(bgs_dml),
     MYSQL_SYSVAR(bgs_first_read),
     MYSQL_SYSVAR(bgs_second_read),
+    MYSQL_SYSVAR(bgs_read_ahead),
+    MYSQL_SYSVAR(bgs_read_ahead_size),
     MYSQL_SYSVAR(ignore_xa_log),
     MYSQL_SYSVAR(first_read),
     MYSQL_SYSVAR(second_read),
     MYSQL_SYSVAR(crd_interval),
     MYSQL_SYSVAR(crd_mode),
+    MYSQL_SYSVAR(crd_explain_cache_interval),
+    MYSQL_SYSVAR(analyze_sample_percent),
 #ifdef WITH_PARTITION_STORAGE_ENGINE
     MYSQL_SYSVAR(crd_sync),
 #endif
@@ -2872,6 +3276,8 @@ static struct st_mysql_sys_var *spider_system_variables[] = {
 #endif
     MYSQL_SYSVAR(store_last_sts),
     MYSQL_SYSVAR(load_sts_at_startup),
+    MYSQL_SYSVAR(preload_sts_crd),
+    MYSQL_SYSVAR(status_refresh_per_backend),
     MYSQL_SYSVAR(sts_bg_mode),
     MYSQL_SYSVAR(ping_interval_at_trx_start),
     MYSQL_SYSVAR(auto_increment_mode),
@@ -2901,6 +3307,7 @@ static struct st_mysql_sys_var *spider_system_variables[] = {
     MYSQL_SYSVAR(connect_mutex),
     MYSQL_SYSVAR(bka_engine),
     MYSQL_SYSVAR(bka_mode),
+    MYSQL_SYSVAR(bka_parallel_search),
     MYSQL_SYSVAR(udf_ct_bulk_insert_interval),
     MYSQL_SYSVAR(udf_ct_bulk_insert_rows),
     MYSQL_SYSVAR(use_handler),
@@ -2909,6 +3316,7 @@ static struct st_mysql_sys_var *spider_system_variables[] = {
     MYSQL_SYSVAR(skip_default_condition),
     MYSQL_SYSVAR(skip_parallel_search),
     MYSQL_SYSVAR(direct_order_limit),
+    MYSQL_SYSVAR(partition_wise_join),
     MYSQL_SYSVAR(read_only_mode),
 #ifdef HA_CAN_BULK_ACCESS
     MYSQL_SYSVAR(bulk_access_free),
@@ -2922,6 +3330,11 @@ static struct st_mysql_sys_var *spider_system_variables[] = {
     MYSQL_SYSVAR(index_hint_pushdown),
     MYSQL_SYSVAR(max_connections),
     MYSQL_SYSVAR(conn_wait_timeout),
+    MYSQL_SYSVAR(conn_wait_priority),
+    MYSQL_SYSVAR(conn_pool_min_idle),
+    MYSQL_SYSVAR(conn_pool_maintain_interval),
+    MYSQL_SYSVAR(config_table_cache_interval),
+    MYSQL_SYSVAR(point_batch_window),
     MYSQL_SYSVAR(ignore_autocommit),
     MYSQL_SYSVAR(fetch_minimum_columns),
     MYSQL_SYSVAR(log_result_errors),
@@ -22,6 +22,7 @@ int spider_param_use_table_charset(int use_table_charset);
 uint spider_param_conn_recycle_mode(THD *thd);
 uint spider_param_conn_recycle_strict(THD *thd);
 bool spider_param_sync_trx_isolation(THD *thd);
+bool spider_param_conn_multiplex(THD *thd);
 bool spider_param_use_consistent_snapshot(THD *thd);
 bool spider_param_internal_xa(THD *thd);
 uint spider_param_internal_xa_snapshot(THD *thd);
@@ -48,8 +49,10 @@ bool spider_param_sync_time_zone(THD *thd);
 bool spider_param_use_default_database(THD *thd);
 int spider_param_internal_sql_log_off(THD *thd);
 int spider_param_bulk_size(THD *thd, int bulk_size);
+uint spider_param_bulk_insert_buffer_size(THD *thd);
 int spider_param_bulk_update_mode(THD *thd, int bulk_update_mode);
 int spider_param_bulk_update_size(THD *thd, int bulk_update_size);
+uint spider_param_bulk_update_buffer_size(THD *thd);
 int spider_param_internal_optimize(THD *thd, int internal_optimize);
 int spider_param_internal_optimize_local(THD *thd, int internal_optimize_local);
 bool spider_param_use_flash_logs(THD *thd);
@@ -61,6 +64,7 @@ bool spider_param_semi_trx(THD *thd);
 int spider_param_connect_timeout(THD *thd, int connect_timeout);
 int spider_param_net_read_timeout(THD *thd, int net_read_timeout);
 int spider_param_net_write_timeout(THD *thd, int net_write_timeout);
+int spider_param_net_compress(THD *thd, int net_compress);
 int spider_param_quick_mode(THD *thd, int quick_mode);
 longlong spider_param_quick_page_size(THD *thd, longlong quick_page_size);
 int spider_param_low_mem_read(THD *thd, int low_mem_read);
@@ -70,10 +74,14 @@ int spider_param_bgs_dml(THD *thd);
 bool spider_param_ignore_xa_log(THD *thd);
 longlong spider_param_bgs_first_read(THD *thd, longlong bgs_first_read);
 longlong spider_param_bgs_second_read(THD *thd, longlong bgs_second_read);
+uint spider_param_bgs_read_ahead(THD *thd);
+longlong spider_param_bgs_read_ahead_size(THD *thd);
 longlong spider_param_first_read(THD *thd, longlong first_read);
 longlong spider_param_second_read(THD *thd, longlong second_read);
 double spider_param_crd_interval(THD *thd, double crd_interval);
 int spider_param_crd_mode(THD *thd, int crd_mode);
+uint spider_param_crd_explain_cache_interval();
+uint spider_param_analyze_sample_percent(THD *thd);
 #ifdef WITH_PARTITION_STORAGE_ENGINE
 int spider_param_crd_sync(THD *thd, int crd_sync);
 #endif
@@ -112,6 +120,7 @@ longlong spider_param_connect_retry_interval(THD *thd);
 int spider_param_connect_retry_count(THD *thd);
 char *spider_param_bka_engine(THD *thd, char *bka_engine);
 int spider_param_bka_mode(THD *thd, int bka_mode);
+bool spider_param_bka_parallel_search(THD *thd);
 int spider_param_udf_ct_bulk_insert_interval(int udf_ct_bulk_insert_interval);
 longlong spider_param_udf_ct_bulk_insert_rows(longlong udf_ct_bulk_insert_rows);
 int spider_param_use_handler(THD *thd, int use_handler);
@@ -120,6 +129,7 @@ int spider_param_error_write_mode(THD *thd, int error_write_mode);
 int spider_param_skip_default_condition(THD *thd, int skip_default_condition);
 int spider_param_skip_parallel_search(THD *thd, int skip_parallel_search);
 longlong spider_param_direct_order_limit(THD *thd, longlong direct_order_limit);
+bool spider_param_partition_wise_join(THD *thd);
 int spider_param_read_only_mode(THD *thd, int read_only_mode);
 #ifdef HA_CAN_BULK_ACCESS
 int spider_param_bulk_access_free(int bulk_access_free);
@@ -137,6 +147,11 @@ my_bool spider_param_enable_mem_calc();
 my_bool spider_param_enable_trx_ha();
 uint spider_param_max_connections();
 uint spider_param_conn_wait_timeout();
+uint spider_param_conn_wait_priority(THD *thd);
+uint spider_param_conn_pool_min_idle();
+uint spider_param_conn_pool_maintain_interval();
+uint spider_param_config_table_cache_interval();
+uint spider_param_point_batch_window(THD *thd);
 my_bool spider_param_fetch_minimum_columns();
 my_bool spider_param_ignore_autocommit();
 my_bool spider_param_quick_mode_only_select();
@@ -151,6 +166,8 @@ int spider_param_store_last_sts(int store_last_sts);
 int spider_param_store_last_crd(int store_last_crd);
 int spider_param_load_sts_at_startup(int load_sts_at_startup);
 int spider_param_load_crd_at_startup(int load_crd_at_startup);
+my_bool spider_param_preload_sts_crd();
+uint spider_param_status_refresh_per_backend();
 uint spider_param_table_sts_thread_count();
 uint spider_param_table_crd_thread_count();
 bool spider_param_trans_rollback(THD *thd);
\ No newline at end of file
@@ -38,6 +38,14 @@
 
 extern handlerton *spider_hton_ptr;
 extern Time_zone *spd_tz_system;
+extern HASH spider_sys_stats_preload_hash;
+extern pthread_mutex_t spider_sys_stats_preload_mutex;
+/*
+  0 : spider_table_sts/crd/status are not scanned yet
+  1 : scanned, spider_sys_stats_preload_hash holds every persisted row
+ -1 : scan failed, use per-table lookups
+*/
+static int spider_sys_stats_preload_state = 0;
 static const LEX_CSTRING empty_clex_string = {"", 0};
 
 /**
@@ -2023,6 +2031,47 @@ void spider_get_sys_table_crd_info(TABLE *table, longlong *cardinality,
   DBUG_VOID_RETURN;
 }
 
+void spider_get_sys_table_status_info(TABLE *table, MEM_ROOT *mem_root,
+                                      ulonglong *data_file_length,
+                                      ulonglong *max_data_file_length,
+                                      ulonglong *index_file_length,
+                                      ha_rows *records, ulong *mean_rec_length,
+                                      time_t *modify_time) {
+  char *ptr;
+  DBUG_ENTER("spider_get_sys_table_status_info");
+  ptr = get_field(mem_root, table->field[4]);
+  if (ptr) {
+    *data_file_length = strtoull(ptr, (char **)NULL, 10);
+  }
+  ptr = get_field(mem_root, table->field[5]);
+  if (ptr) {
+    *max_data_file_length = strtoull(ptr, (char **)NULL, 10);
+  }
+  ptr = get_field(mem_root, table->field[6]);
+  if (ptr) {
+    *index_file_length = strtoull(ptr, (char **)NULL, 10);
+  }
+  ptr = get_field(mem_root, table->field[7]);
+  if (ptr) {
+    *records = strtoull(ptr, (char **)NULL, 10);
+  }
+  ptr = get_field(mem_root, table->field[8]);
+  if (ptr) {
+    *mean_rec_length = strtoul(ptr, (char **)NULL, 10);
+  }
+  ptr = get_field(mem_root, table->field[12]);
+  if (ptr) {
+    MYSQL_TIME tm;
+    long dummy_my_timezone;
+    uint dummy_in_dst_time_gap;
+    MYSQL_TIME_STATUS status;
+    str_to_time(ptr, 19, &tm, TIME_TIME_ONLY, &status);
+    *modify_time =
+        my_system_gmt_sec(&tm, &dummy_my_timezone, &dummy_in_dst_time_gap);
+  }
+  DBUG_VOID_RETURN;
+}
+
 int spider_sys_update_tables_link_status(THD *thd, char *name, uint name_length,
                                          int link_idx, long link_status,
                                          bool need_lock) {
@@ -2338,6 +2387,395 @@ int spider_get_link_statuses(TABLE *table, SPIDER_SHARE *share,
   DBUG_RETURN(0);
 }
 
+uchar *spider_sys_stats_preload_get_key(SPIDER_SYS_STATS_PRELOAD *preload,
+                                        size_t *length,
+                                        my_bool not_used
+                                        __attribute__((unused))) {
+  DBUG_ENTER("spider_sys_stats_preload_get_key");
+  *length = preload->table_name_length;
+  DBUG_RETURN((uchar *)preload->table_name);
+}
+
+void spider_sys_stats_preload_free(void *info) {
+  SPIDER_SYS_STATS_PRELOAD *preload = (SPIDER_SYS_STATS_PRELOAD *)info;
+  DBUG_ENTER("spider_sys_stats_preload_free");
+  if (preload->cardinality) spider_free(NULL, preload->cardinality, MYF(0));
+  spider_free(NULL, preload, MYF(0));
+  DBUG_VOID_RETURN;
+}
+
+/* need spider_sys_stats_preload_mutex */
+static SPIDER_SYS_STATS_PRELOAD *spider_sys_stats_preload_get(
+    const char *name, uint name_length, bool create) {
+  SPIDER_SYS_STATS_PRELOAD *preload;
+  char *tmp_name;
+  DBUG_ENTER("spider_sys_stats_preload_get");
+  if ((preload = (SPIDER_SYS_STATS_PRELOAD *)my_hash_search(
+           &spider_sys_stats_preload_hash, (uchar *)name, name_length)) ||
+      !create)
+    DBUG_RETURN(preload);
+  if (!(preload = (SPIDER_SYS_STATS_PRELOAD *)spider_bulk_malloc(
+            spider_current_trx, 200, MYF(MY_WME | MY_ZEROFILL), &preload,
+            (uint)(sizeof(*preload)), &tmp_name, (uint)(name_length + 1),
+            NullS)))
+    DBUG_RETURN(NULL);
+  preload->table_name = tmp_name;
+  preload->table_name_length = name_length;
+  memcpy(tmp_name, name, name_length);
+  if (my_hash_insert(&spider_sys_stats_preload_hash, (uchar *)preload)) {
+    spider_free(NULL, preload, MYF(0));
+    DBUG_RETURN(NULL);
+  }
+  DBUG_RETURN(preload);
+}
+
+/* need spider_sys_stats_preload_mutex */
+static int spider_sys_stats_preload_set_crd(SPIDER_SYS_STATS_PRELOAD *preload,
+                                            uint seq, longlong cardinality) {
+  longlong *tmp_cardinality;
+  uint roop_count, crd_count;
+  DBUG_ENTER("spider_sys_stats_preload_set_crd");
+  if (seq >= preload->crd_count) {
+    crd_count = seq + 1;
+    if (crd_count < preload->crd_count * 2) crd_count = preload->crd_count * 2;
+    if (!(tmp_cardinality = (longlong *)spider_malloc(
+              spider_current_trx, 202, sizeof(longlong) * crd_count,
+              MYF(MY_WME))))
+      DBUG_RETURN(HA_ERR_OUT_OF_MEM);
+    for (roop_count = 0; roop_count < crd_count; roop_count++)
+      tmp_cardinality[roop_count] = roop_count < preload->crd_count
+                                        ? preload->cardinality[roop_count]
+                                        : -1;
+    if (preload->cardinality) spider_free(NULL, preload->cardinality, MYF(0));
+    preload->cardinality = tmp_cardinality;
+    preload->crd_count = crd_count;
+  }
+  preload->cardinality[seq] = cardinality;
+  DBUG_RETURN(0);
+}
+
+static void spider_sys_stats_preload_get_name(TABLE *table, String *name) {
+  char buf[MAX_FIELD_WIDTH];
+  String tmp_str(buf, sizeof(buf), system_charset_info);
+  DBUG_ENTER("spider_sys_stats_preload_get_name");
+  name->length(0);
+  name->append(FN_CURLIB);
+  name->append(FN_LIBCHAR);
+  table->field[0]->val_str(&tmp_str);
+  name->append(tmp_str);
+  name->append(FN_LIBCHAR);
+  table->field[1]->val_str(&tmp_str);
+  name->append(tmp_str);
+  DBUG_VOID_RETURN;
+}
+
+/* need spider_sys_stats_preload_mutex */
+static int spider_sys_stats_preload_scan(THD *thd, const char *table_name,
+                                         uint table_name_length,
+                                         bool need_lock) {
+  int error_num;
+  TABLE *table;
+  SPIDER_SYS_STATS_PRELOAD *preload = NULL;
+  bool is_sts =
+      (table_name_length == SPIDER_SYS_TABLE_STS_TABLE_NAME_LEN &&
+       !memcmp(table_name, SPIDER_SYS_TABLE_STS_TABLE_NAME_STR,
+               table_name_length));
+  bool is_status =
+      (table_name_length == SPIDER_SYS_TABLE_STATUS_NAME_LEN &&
+       !memcmp(table_name, SPIDER_SYS_TABLE_STATUS_NAME_STR,
+               table_name_length));
+  char buf[MAX_FIELD_WIDTH];
+  String name(buf, sizeof(buf), system_charset_info);
+  MEM_ROOT mem_root;
+#if MYSQL_VERSION_ID < 50500
+  Open_tables_state open_tables_backup;
+#else
+  Open_tables_backup open_tables_backup;
+#endif
+  DBUG_ENTER("spider_sys_stats_preload_scan");
+  if (!(table = spider_open_sys_table(thd, table_name, table_name_length, TRUE,
+                                      &open_tables_backup, need_lock,
+                                      &error_num))) {
+    /* a stats table that is not installed holds no rows */
+    if (thd->get_stmt_da()->is_error() &&
+        thd->get_stmt_da()->sql_errno() == ER_NO_SUCH_TABLE) {
+      thd->clear_error();
+      DBUG_RETURN(0);
+    }
+    DBUG_RETURN(error_num);
+  }
+  table->use_all_columns();
+  if ((error_num = spider_sys_index_first(table, 0))) {
+    spider_close_sys_table(thd, table, &open_tables_backup, need_lock);
+    if (error_num == HA_ERR_KEY_NOT_FOUND || error_num == HA_ERR_END_OF_FILE)
+      DBUG_RETURN(0);
+    DBUG_RETURN(error_num);
+  }
+  SPD_INIT_ALLOC_ROOT(&mem_root, 4096, 0, MYF(MY_WME));
+  do {
+    spider_sys_stats_preload_get_name(table, &name);
+    /* rows of one table are adjacent in primary key order */
+    if (!preload || preload->table_name_length != name.length() ||
+        memcmp(preload->table_name, name.ptr(), name.length())) {
+      if (!(preload = spider_sys_stats_preload_get(name.ptr(), name.length(),
+                                                   TRUE))) {
+        error_num = HA_ERR_OUT_OF_MEM;
+        break;
+      }
+    }
+    if (is_sts) {
+      spider_get_sys_table_sts_info(
+          table, &preload->data_file_length, &preload->max_data_file_length,
+          &preload->index_file_length, &preload->records,
+          &preload->mean_rec_length, &preload->check_time,
+          &preload->create_time, &preload->update_time);
+      preload->sts_loaded = TRUE;
+    } else if (is_status) {
+      spider_get_sys_table_status_info(
+          table, &mem_root, &preload->status_data_file_length,
+          &preload->status_max_data_file_length,
+          &preload->status_index_file_length, &preload->status_records,
+          &preload->status_mean_rec_length, &preload->status_modify_time);
+      preload->status_loaded = TRUE;
+      free_root(&mem_root, MYF(MY_MARK_BLOCKS_FREE));
+    } else if ((error_num = spider_sys_stats_preload_set_crd(
+                    preload, (uint)table->field[2]->val_int(),
+                    (longlong)table->field[3]->val_int())))
+      break;
+  } while (!(error_num = spider_sys_index_next(table)));
+  spider_sys_index_end(table);
+  spider_close_sys_table(thd, table, &open_tables_backup, need_lock);
+  free_root(&mem_root, MYF(0));
+  DBUG_RETURN(error_num == HA_ERR_END_OF_FILE ? 0 : error_num);
+}
+
+/* need spider_sys_stats_preload_mutex */
+static bool spider_sys_stats_preload_ready(THD *thd, bool need_lock) {
+  DBUG_ENTER("spider_sys_stats_preload_ready");
+  if (!spider_sys_stats_preload_state) {
+    if (spider_sys_stats_preload_scan(thd, SPIDER_SYS_TABLE_STS_TABLE_NAME_STR,
+                                      SPIDER_SYS_TABLE_STS_TABLE_NAME_LEN,
+                                      need_lock) ||
+        spider_sys_stats_preload_scan(thd, SPIDER_SYS_TABLE_CRD_TABLE_NAME_STR,
+                                      SPIDER_SYS_TABLE_CRD_TABLE_NAME_LEN,
+                                      need_lock) ||
+        spider_sys_stats_preload_scan(thd, SPIDER_SYS_TABLE_STATUS_NAME_STR,
+                                      SPIDER_SYS_TABLE_STATUS_NAME_LEN,
+                                      need_lock)) {
+      my_hash_reset(&spider_sys_stats_preload_hash);
+      thd->clear_error();
+      spider_sys_stats_preload_state = -1;
+    } else
+      spider_sys_stats_preload_state = 1;
+  }
+  DBUG_RETURN(spider_sys_stats_preload_state == 1);
+}
+
+/**
+  Look up persisted sts in the bulk preloaded copy of spider_table_sts.
+
+  @return  FALSE if the caller has to read spider_table_sts itself,
+           TRUE if *error_num holds the result (0 or HA_ERR_KEY_NOT_FOUND).
+*/
+
+static bool spider_sys_stats_preload_sts(
+    THD *thd, const char *name, uint name_length, ulonglong *data_file_length,
+    ulonglong *max_data_file_length, ulonglong *index_file_length,
+    ha_rows *records, ulong *mean_rec_length, time_t *check_time,
+    time_t *create_time, time_t *update_time, bool need_lock, int *error_num) {
+  SPIDER_SYS_STATS_PRELOAD *preload;
+  DBUG_ENTER("spider_sys_stats_preload_sts");
+  pthread_mutex_lock(&spider_sys_stats_preload_mutex);
+  if (!spider_sys_stats_preload_ready(thd, need_lock)) {
+    pthread_mutex_unlock(&spider_sys_stats_preload_mutex);
+    DBUG_RETURN(FALSE);
+  }
+  if ((preload = spider_sys_stats_preload_get(name, name_length, FALSE)) &&
+      preload->sts_loaded) {
+    *data_file_length = preload->data_file_length;
+    *max_data_file_length = preload->max_data_file_length;
+    *index_file_length = preload->index_file_length;
+    *records = preload->records;
+    *mean_rec_length = preload->mean_rec_length;
+    *check_time = preload->check_time;
+    *create_time = preload->create_time;
+    *update_time = preload->update_time;
+    *error_num = 0;
+  } else
+    *error_num = HA_ERR_KEY_NOT_FOUND;
+  pthread_mutex_unlock(&spider_sys_stats_preload_mutex);
+  DBUG_RETURN(TRUE);
+}
+
+/**
+  Look up persisted crd in the bulk preloaded copy of spider_table_crd.
+
+  @return  FALSE if the caller has to read spider_table_crd itself,
+           TRUE if *error_num holds the result (0 or HA_ERR_KEY_NOT_FOUND).
+*/
+
+static bool spider_sys_stats_preload_crd(THD *thd, const char *name,
+                                         uint name_length,
+                                         longlong *cardinality,
+                                         uint number_of_keys, bool need_lock,
+                                         int *error_num) {
+  SPIDER_SYS_STATS_PRELOAD *preload;
+  uint roop_count;
+  DBUG_ENTER("spider_sys_stats_preload_crd");
+  pthread_mutex_lock(&spider_sys_stats_preload_mutex);
+  if (!spider_sys_stats_preload_ready(thd, need_lock)) {
+    pthread_mutex_unlock(&spider_sys_stats_preload_mutex);
+    DBUG_RETURN(FALSE);
+  }
+  if ((preload = spider_sys_stats_preload_get(name, name_length, FALSE)) &&
+      preload->crd_count) {
+    for (roop_count = 0;
+         roop_count < preload->crd_count && roop_count < number_of_keys;
+         roop_count++) {
+      if (preload->cardinality[roop_count] != -1)
+        cardinality[roop_count] = preload->cardinality[roop_count];
+    }
+    *error_num = 0;
+  } else
+    *error_num = HA_ERR_KEY_NOT_FOUND;
+  pthread_mutex_unlock(&spider_sys_stats_preload_mutex);
+  DBUG_RETURN(TRUE);
+}
+
+/* keep the preloaded copy in step with writes to spider_table_sts */
+static void spider_sys_stats_preload_store_sts(
+    const char *name, uint name_length, ulonglong *data_file_length,
+    ulonglong *max_data_file_length, ulonglong *index_file_length,
+    ha_rows *records, ulong *mean_rec_length, time_t *check_time,
+    time_t *create_time, time_t *update_time) {
+  SPIDER_SYS_STATS_PRELOAD *preload;
+  DBUG_ENTER("spider_sys_stats_preload_store_sts");
+  pthread_mutex_lock(&spider_sys_stats_preload_mutex);
+  if (spider_sys_stats_preload_state == 1) {
+    if (!(preload = spider_sys_stats_preload_get(name, name_length,
+                                                 data_file_length != NULL))) {
+      if (data_file_length) {
+        /* lost track of this table, stop serving from memory */
+        my_hash_reset(&spider_sys_stats_preload_hash);
+        spider_sys_stats_preload_state = -1;
+      }
+    } else if (data_file_length) {
+      preload->data_file_length = *data_file_length;
+      preload->max_data_file_length = *max_data_file_length;
+      preload->index_file_length = *index_file_length;
+      preload->records = *records;
+      preload->mean_rec_length = *mean_rec_length;
+      preload->check_time = *check_time;
+      preload->create_time = *create_time;
+      preload->update_time = *update_time;
+      preload->sts_loaded = TRUE;
+    } else
+      preload->sts_loaded = FALSE;
+  }
+  pthread_mutex_unlock(&spider_sys_stats_preload_mutex);
+  DBUG_VOID_RETURN;
+}
+
+/* keep the preloaded copy in step with writes to spider_table_crd */
+static void spider_sys_stats_preload_store_crd(const char *name,
+                                               uint name_length,
+                                               longlong *cardinality,
+                                               uint number_of_keys) {
+  SPIDER_SYS_STATS_PRELOAD *preload;
+  uint roop_count;
+  bool lost = FALSE;
+  DBUG_ENTER("spider_sys_stats_preload_store_crd");
+  pthread_mutex_lock(&spider_sys_stats_preload_mutex);
+  if (spider_sys_stats_preload_state == 1) {
+    if (!(preload = spider_sys_stats_preload_get(name, name_length,
+                                                 cardinality != NULL)))
+      lost = (cardinality != NULL);
+    else {
+      if (preload->cardinality) spider_free(NULL, preload->cardinality, MYF(0));
+      preload->cardinality = NULL;
+      preload->crd_count = 0;
+      for (roop_count = 0; cardinality && roop_count < number_of_keys;
+           roop_count++) {
+        if (spider_sys_stats_preload_set_crd(preload, roop_count,
+                                             cardinality[roop_count])) {
+          lost = TRUE;
+          break;
+        }
+      }
+    }
+    if (lost) {
+      /* lost track of this table, stop serving from memory */
+      my_hash_reset(&spider_sys_stats_preload_hash);
+      spider_sys_stats_preload_state = -1;
+    }
+  }
+  pthread_mutex_unlock(&spider_sys_stats_preload_mutex);
+  DBUG_VOID_RETURN;
+}
+
+/**
+  Look up persisted statistics in the bulk preloaded copy of
+  spider_table_status.
+
+  @return  FALSE if the caller has to read spider_table_status itself,
+           TRUE if *error_num holds the result (0 or HA_ERR_KEY_NOT_FOUND).
+*/
+
+static bool spider_sys_stats_preload_status(THD *thd, SPIDER_SHARE *share,
+                                            int *error_num) {
+  SPIDER_SYS_STATS_PRELOAD *preload;
+  DBUG_ENTER("spider_sys_stats_preload_status");
+  pthread_mutex_lock(&spider_sys_stats_preload_mutex);
+  if (!spider_sys_stats_preload_ready(thd, FALSE)) {
+    pthread_mutex_unlock(&spider_sys_stats_preload_mutex);
+    DBUG_RETURN(FALSE);
+  }
+  if ((preload = spider_sys_stats_preload_get(
+           share->table_name, share->table_name_length, FALSE)) &&
+      preload->status_loaded) {
+    share->data_file_length = preload->status_data_file_length;
+    share->max_data_file_length = preload->status_max_data_file_length;
+    share->index_file_length = preload->status_index_file_length;
+    share->records = preload->status_records;
+    share->mean_rec_length = preload->status_mean_rec_length;
+    share->modify_time = preload->status_modify_time;
+    *error_num = 0;
+  } else
+    *error_num = HA_ERR_KEY_NOT_FOUND;
+  pthread_mutex_unlock(&spider_sys_stats_preload_mutex);
+  DBUG_RETURN(TRUE);
+}
+
+/* keep the preloaded copy in step with writes to spider_table_status */
+static void spider_sys_stats_preload_store_status(TABLE *table) {
+  SPIDER_SYS_STATS_PRELOAD *preload;
+  char buf[MAX_FIELD_WIDTH];
+  String name(buf, sizeof(buf), system_charset_info);
+  MEM_ROOT mem_root;
+  DBUG_ENTER("spider_sys_stats_preload_store_status");
+  pthread_mutex_lock(&spider_sys_stats_preload_mutex);
+  if (spider_sys_stats_preload_state == 1) {
+    spider_sys_stats_preload_get_name(table, &name);
+    if (!(preload = spider_sys_stats_preload_get(name.ptr(), name.length(),
+                                                 TRUE))) {
+      /* lost track of this table, stop serving from memory */
+      my_hash_reset(&spider_sys_stats_preload_hash);
+      spider_sys_stats_preload_state = -1;
+    } else {
+      SPD_INIT_ALLOC_ROOT(&mem_root, 4096, 0, MYF(MY_WME));
+      spider_get_sys_table_status_info(
+          table, &mem_root, &preload->status_data_file_length,
+          &preload->status_max_data_file_length,
+          &preload->status_index_file_length, &preload->status_records,
+          &preload->status_mean_rec_length, &preload->status_modify_time);
+      preload->status_loaded = TRUE;
+      free_root(&mem_root, MYF(0));
+    }
+  }
+  pthread_mutex_unlock(&spider_sys_stats_preload_mutex);
+  DBUG_VOID_RETURN;
+}
+
 int spider_sys_insert_or_update_table_sts(
     THD *thd, const char *name, uint name_length, ulonglong *data_file_length,
     ulonglong *max_data_file_length, ulonglong *index_file_length,
@@ -2362,6 +2800,10 @@ int spider_sys_insert_or_update_table_sts(
            index_file_length, records, mean_rec_length, check_time, create_time,
            update_time)))
     goto error;
+  spider_sys_stats_preload_store_sts(
+      name, name_length, data_file_length, max_data_file_length,
+      index_file_length, records, mean_rec_length, check_time, create_time,
+      update_time);
   spider_close_sys_table(thd, table_sts, &open_tables_backup, need_lock);
   table_sts = NULL;
   DBUG_RETURN(0);
@@ -2393,6 +2835,8 @@ int spider_sys_insert_or_update_table_crd(THD *thd, const char *name,
   if ((error_num = spider_insert_or_update_table_crd(
            table_crd, name, name_length, cardinality, number_of_keys)))
     goto error;
+  spider_sys_stats_preload_store_crd(name, name_length, cardinality,
+                                     number_of_keys);
   spider_close_sys_table(thd, table_crd, &open_tables_backup, need_lock);
   table_crd = NULL;
   DBUG_RETURN(0);
@@ -2421,6 +2865,8 @@ int spider_sys_delete_table_sts(THD *thd, const char *name, uint name_length,
   }
   if ((error_num = spider_delete_table_sts(table_sts, name, name_length)))
     goto error;
+  spider_sys_stats_preload_store_sts(name, name_length, NULL, NULL, NULL, NULL,
+                                     NULL, NULL, NULL, NULL);
   spider_close_sys_table(thd, table_sts, &open_tables_backup, need_lock);
   table_sts = NULL;
   DBUG_RETURN(0);
@@ -2449,6 +2895,7 @@ int spider_sys_delete_table_crd(THD *thd, const char *name, uint name_length,
   }
   if ((error_num = spider_delete_table_crd(table_crd, name, name_length)))
     goto error;
+  spider_sys_stats_preload_store_crd(name, name_length, NULL, 0);
   spider_close_sys_table(thd, table_crd, &open_tables_backup, need_lock);
   table_crd = NULL;
   DBUG_RETURN(0);
@@ -2475,6 +2922,12 @@ int spider_sys_get_table_sts(THD *thd, const char *name, uint name_length,
   Open_tables_backup open_tables_backup;
 #endif
   DBUG_ENTER("spider_sys_get_table_sts");
+  if (spider_param_preload_sts_crd() &&
+      spider_sys_stats_preload_sts(
+          thd, name, name_length, data_file_length, max_data_file_length,
+          index_file_length, records, mean_rec_length, check_time, create_time,
+          update_time, need_lock, &error_num))
+    DBUG_RETURN(error_num);
   if (!(table_sts = spider_open_sys_table(
             thd, SPIDER_SYS_TABLE_STS_TABLE_NAME_STR,
             SPIDER_SYS_TABLE_STS_TABLE_NAME_LEN, TRUE, &open_tables_backup,
@@ -2518,6 +2971,10 @@ int spider_sys_get_table_crd(THD *thd, const char *name, uint name_length,
   Open_tables_backup open_tables_backup;
 #endif
   DBUG_ENTER("spider_sys_get_table_crd");
+  if (spider_param_preload_sts_crd() &&
+      spider_sys_stats_preload_crd(thd, name, name_length, cardinality,
+                                   number_of_keys, need_lock, &error_num))
+    DBUG_RETURN(error_num);
   if (!(table_crd = spider_open_sys_table(
             thd, SPIDER_SYS_TABLE_CRD_TABLE_NAME_STR,
             SPIDER_SYS_TABLE_CRD_TABLE_NAME_LEN, TRUE, &open_tables_backup,
@@ -2883,7 +3340,6 @@ int spider_get_table_status_record(TABLE *table, char *table_name,
 }
 
 int spider_get_table_status_for_share(SPIDER_SHARE *share) {
-  char *ptr;
   int error_num = 0;
   MEM_ROOT mem_root;
   TABLE *table;
@@ -2906,6 +3362,16 @@ int spider_get_table_status_for_share(SPIDER_SHARE *share) {
   share->sts_read_time =
       tmp_time + rand() % 600; /* avoid reading tables at the same time
                                   tb_spider_table_status  */
+  if (spider_param_preload_sts_crd() &&
+      spider_sys_stats_preload_status(thd, share, &error_num)) {
+    if (error_num) {
+      share->sts_read_time = 0;
+      share->modify_time = 0;
+    } else
+      share->sts_get_time = tmp_time;
+    free_root(&mem_root, MYF(0));
+    DBUG_RETURN(error_num);
+  }
   if (!(table =
             spider_open_sys_table(thd, SPIDER_SYS_TABLE_STATUS_NAME_STR,
                                   SPIDER_SYS_TABLE_STATUS_NAME_LEN, TRUE,
@@ -2922,38 +3388,10 @@ int spider_get_table_status_for_share(SPIDER_SHARE *share) {
     DBUG_RETURN(error_num);
   }
 
-  ptr = get_field(&mem_root, table->field[4]);
-  if (ptr) {
-    share->data_file_length = strtoull(ptr, (char **)NULL, 10);
-  }
-  ptr = get_field(&mem_root, table->field[5]);
-  if (ptr) {
-    share->max_data_file_length = strtoull(ptr, (char **)NULL, 10);
-  }
-  ptr = get_field(&mem_root, table->field[6]);
-  if (ptr) {
-    share->index_file_length = strtoull(ptr, (char **)NULL, 10);
-  }
-  ptr = get_field(&mem_root, table->field[7]);
-  if (ptr) {
-    share->records = strtoull(ptr, (char **)NULL, 10);
-  }
-  ptr = get_field(&mem_root, table->field[8]);
-  if (ptr) {
-    share->mean_rec_length = strtoul(ptr, (char **)NULL, 10);
-  }
-  ptr = get_field(&mem_root, table->field[12]);
-  if (ptr) {
-    MYSQL_TIME tm;
-    long dummy_my_timezone;
-    time_t tmp_time;
-    uint dummy_in_dst_time_gap;
-    MYSQL_TIME_STATUS status;
-    str_to_time(ptr, 19, &tm, TIME_TIME_ONLY, &status);
-    tmp_time =
-        my_system_gmt_sec(&tm, &dummy_my_timezone, &dummy_in_dst_time_gap);
-    share->modify_time = tmp_time;
-  }
+  spider_get_sys_table_status_info(
+      table, &mem_root, &share->data_file_length, &share->max_data_file_length,
+      &share->index_file_length, &share->records, &share->mean_rec_length,
+      &share->modify_time);
 
   /** time
   ptr = get_field(mem_root, table->field[9]);
@@ -3014,6 +3452,7 @@ int spider_replace_table_status(TABLE *table, char *table_name,
         data_file_length, max_data_file_length, index_file_length, records,
         mean_rec_length, check_time, create_time, update_time);
   }
+  if (!error_num) spider_sys_stats_preload_store_status(table);
   DBUG_RETURN(0);
 }
 
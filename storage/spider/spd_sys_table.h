@@ -283,6 +283,13 @@ void spider_get_sys_table_sts_info(TABLE *table, ulonglong *data_file_length,
 void spider_get_sys_table_crd_info(TABLE *table, longlong *cardinality,
                                    uint number_of_keys);
 
+void spider_get_sys_table_status_info(TABLE *table, MEM_ROOT *mem_root,
+                                      ulonglong *data_file_length,
+                                      ulonglong *max_data_file_length,
+                                      ulonglong *index_file_length,
+                                      ha_rows *records, ulong *mean_rec_length,
+                                      time_t *modify_time);
+
 int spider_sys_update_tables_link_status(THD *thd, char *name, uint name_length,
                                          int link_idx, long link_status,
                                          bool need_lock);
@@ -305,6 +312,13 @@ int spider_get_sys_link_mon_connect_info(TABLE *table, SPIDER_SHARE *share,
 int spider_get_link_statuses(TABLE *table, SPIDER_SHARE *share,
                              MEM_ROOT *mem_root);
 
+uchar *spider_sys_stats_preload_get_key(SPIDER_SYS_STATS_PRELOAD *preload,
+                                        size_t *length,
+                                        my_bool not_used
+                                        __attribute__((unused)));
+
+void spider_sys_stats_preload_free(void *info);
+
 int spider_sys_insert_or_update_table_sts(
     THD *thd, const char *name, uint name_length, ulonglong *data_file_length,
     ulonglong *max_data_file_length, ulonglong *index_file_length,
@@ -29,6 +29,7 @@
 #include "sql_servers.h"
 #include "sql_select.h"
 #include "tztime.h"
+#include "key.h"
 #endif
 #include "spd_err.h"
 #include "spd_param.h"
@@ -124,6 +125,8 @@ SPIDER_THREAD *spider_table_crd_threads;
 
 const int SPIDER_CONN_POOL_HASH_INIT_SIZE = 128;
 
+PSI_stage_info spd_stage_point_batch = {0, "Waiting for point batch", 0};
+
 #ifdef HAVE_PSI_INTERFACE
 PSI_mutex_key spd_key_mutex_tbl;
 PSI_mutex_key spd_key_mutex_init_error_tbl;
@@ -131,6 +134,7 @@ PSI_mutex_key spd_key_mutex_init_error_tbl;
 PSI_mutex_key spd_key_mutex_pt_share;
 #endif
 PSI_mutex_key spd_key_mutex_lgtm_tblhnd_share;
+PSI_mutex_key spd_key_mutex_sys_stats_preload;
 // spd_key_mutex_conn is deprecated since we re-design the conn pool
 PSI_mutex_key spd_key_mutex_conn;
 PSI_mutex_key spd_key_mutex_conn_meta;
@@ -177,6 +181,7 @@ static PSI_mutex_info all_spider_mutexes[] = {
     {&spd_key_mutex_pt_share, "pt_share", PSI_FLAG_GLOBAL},
 #endif
     {&spd_key_mutex_lgtm_tblhnd_share, "lgtm_tblhnd_share", PSI_FLAG_GLOBAL},
+    {&spd_key_mutex_sys_stats_preload, "sys_stats_preload", PSI_FLAG_GLOBAL},
     {&spd_key_mutex_conn, "conn", PSI_FLAG_GLOBAL},
     {&spd_key_mutex_conn_meta, "conn_meta", PSI_FLAG_GLOBAL},
     {&spd_key_mutex_open_conn, "open_conn", PSI_FLAG_GLOBAL},
@@ -230,6 +235,7 @@ PSI_cond_key spd_key_cond_bg_stss;
 PSI_cond_key spd_key_cond_bg_sts_syncs;
 PSI_cond_key spd_key_cond_bg_crds;
 PSI_cond_key spd_key_cond_bg_crd_syncs;
+PSI_cond_key spd_key_cond_point_batch;
 
 static PSI_cond_info all_spider_conds[] = {
     {&spd_key_cond_bg_conn_sync, "bg_conn_sync", 0},
@@ -247,6 +253,7 @@ static PSI_cond_info all_spider_conds[] = {
     {&spd_key_cond_bg_sts_syncs, "bg_sts_syncs", 0},
     {&spd_key_cond_bg_crds, "bg_crds", 0},
     {&spd_key_cond_bg_crd_syncs, "bg_crd_syncs", 0},
+    {&spd_key_cond_point_batch, "point_batch", 0},
 };
 
 PSI_thread_key spd_key_thd_bg;
@@ -256,8 +263,11 @@ PSI_thread_key spd_key_thd_bg_mon;
 PSI_thread_key spd_key_thd_bg_stss;
 PSI_thread_key spd_key_thd_bg_crds;
 PSI_thread_key spd_key_thd_conn_rcyc;
+PSI_thread_key spd_key_thd_conn_pool_maintain;
 PSI_thread_key spd_key_thd_get_status;
 
+static PSI_stage_info *all_spider_stages[] = {&spd_stage_point_batch};
+
 static PSI_thread_info all_spider_threads[] = {
     {&spd_key_thd_bg, "bg", 0},
     {&spd_key_thd_bg_sts, "bg_sts", 0},
@@ -266,6 +276,7 @@ static PSI_thread_info all_spider_threads[] = {
     {&spd_key_thd_bg_stss, "bg_stss", 0},
     {&spd_key_thd_bg_crds, "bg_crds", 0},
     {&spd_key_thd_conn_rcyc, "conn_rcyc", 0},
+    {&spd_key_thd_conn_pool_maintain, "conn_pool_maintain", 0},
 };
 #endif
 
@@ -328,6 +339,9 @@ const char *spider_lgtm_tblhnd_share_hash_file_name;
 ulong spider_lgtm_tblhnd_share_hash_line_no;
 pthread_mutex_t spider_lgtm_tblhnd_share_mutex;
 
+HASH spider_sys_stats_preload_hash;
+pthread_mutex_t spider_sys_stats_preload_mutex;
+
 HASH spider_allocated_thds;
 uint spider_allocated_thds_id;
 const char *spider_allocated_thds_func_name;
@@ -427,6 +441,8 @@ static void init_spider_psi_keys() {
                             array_elements(all_spider_conds));
   PSI_server->register_thread("spider", all_spider_threads,
                               array_elements(all_spider_threads));
+  PSI_server->register_stage("spider", all_spider_stages,
+                             array_elements(all_spider_stages));
   DBUG_VOID_RETURN;
 }
 #endif
@@ -736,6 +752,8 @@ int spider_free_share_alloc(SPIDER_SHARE *share) {
     spider_free(spider_current_trx, share->net_read_timeouts, MYF(0));
   if (share->net_write_timeouts)
     spider_free(spider_current_trx, share->net_write_timeouts, MYF(0));
+  if (share->net_compresses)
+    spider_free(spider_current_trx, share->net_compresses, MYF(0));
   if (share->access_balances)
     spider_free(spider_current_trx, share->access_balances, MYF(0));
   if (share->bka_table_name_types)
@@ -1766,6 +1784,7 @@ int spider_parse_connect_info(SPIDER_SHARE *share, TABLE_SHARE *table_share,
           SPIDER_PARAM_INT_WITH_MAX("cbm", crd_bg_mode, 0, 2);
           SPIDER_PARAM_DOUBLE("civ", crd_interval, 0);
           SPIDER_PARAM_INT_WITH_MAX("cmd", crd_mode, 0, 3);
+          SPIDER_PARAM_LONG_LIST_WITH_MAX("cmp", net_compresses, 0, 1);
           SPIDER_PARAM_INT_WITH_MAX("csr", casual_read, 0, 63);
 #ifdef WITH_PARTITION_STORAGE_ENGINE
           SPIDER_PARAM_INT_WITH_MAX("csy", crd_sync, 0, 2);
@@ -1901,6 +1920,7 @@ int spider_parse_connect_info(SPIDER_SHARE *share, TABLE_SHARE *table_share,
           SPIDER_PARAM_INT("bgs_mode", bgs_mode, 0);
           SPIDER_PARAM_STR_LIST("ssl_cert", tgt_ssl_certs);
           SPIDER_PARAM_INT_WITH_MAX("bka_mode", bka_mode, 0, 2);
+          SPIDER_PARAM_LONG_LIST_WITH_MAX("compress", net_compresses, 0, 1);
           error_num = connect_string_parse.print_param_error();
           my_printf_error(error_num, ER_SPIDER_INVALID_CONNECT_INFO_STR, MYF(0),
                           tmp_ptr);
@@ -1941,6 +1961,8 @@ int spider_parse_connect_info(SPIDER_SHARE *share, TABLE_SHARE *table_share,
           SPIDER_PARAM_INT_WITH_MAX("low_mem_read", low_mem_read, 0, 1);
           SPIDER_PARAM_STR_LIST("default_file", tgt_default_files);
           SPIDER_PARAM_STR_LIST("config_table", tgt_config_table);
+          SPIDER_PARAM_LONG_LIST_WITH_MAX("net_compress", net_compresses, 0,
+                                          1);
           error_num = connect_string_parse.print_param_error();
           goto error;
         case 13:
@@ -2166,6 +2188,8 @@ int spider_parse_connect_info(SPIDER_SHARE *share, TABLE_SHARE *table_share,
     share->all_link_count = share->net_read_timeouts_length;
   if (share->all_link_count < share->net_write_timeouts_length)
     share->all_link_count = share->net_write_timeouts_length;
+  if (share->all_link_count < share->net_compresses_length)
+    share->all_link_count = share->net_compresses_length;
   if (share->all_link_count < share->access_balances_length)
     share->all_link_count = share->access_balances_length;
   if (share->all_link_count < share->bka_table_name_types_length)
@@ -2325,6 +2349,10 @@ int spider_parse_connect_info(SPIDER_SHARE *share, TABLE_SHARE *table_share,
                                              &share->net_write_timeouts_length,
                                              share->all_link_count)))
     goto error;
+  if ((error_num = spider_increase_long_list(&share->net_compresses,
+                                             &share->net_compresses_length,
+                                             share->all_link_count)))
+    goto error;
   if ((error_num = spider_increase_long_list(&share->access_balances,
                                              &share->access_balances_length,
                                              share->all_link_count)))
@@ -3072,6 +3100,8 @@ int spider_set_connect_info_default(SPIDER_SHARE *share,
       share->net_read_timeouts[roop_count] = 600;
     if (share->net_write_timeouts[roop_count] == -1)
       share->net_write_timeouts[roop_count] = 600;
+    if (share->net_compresses[roop_count] == -1)
+      share->net_compresses[roop_count] = 0;
     if (share->access_balances[roop_count] == -1)
       share->access_balances[roop_count] = 100;
     if (share->bka_table_name_types[roop_count] == -1)
@@ -4273,6 +4303,9 @@ int spider_free_share(SPIDER_SHARE *share) {
          FALSE
        );
      }*/
+    if (share->config_cache)
+      spider_free(spider_current_trx, share->config_cache, MYF(0));
+    spider_free_range_estimates(share);
     spider_free_share_alloc(share);
     my_hash_delete(&spider_open_tables, (uchar *)share);
     thr_lock_delete(&share->lock);
@@ -4287,6 +4320,228 @@ int spider_free_share(SPIDER_SHARE *share) {
   DBUG_RETURN(0);
 }
 
+/*
+  Return the cached copy of a config table when it was loaded within
+  interval seconds. *version receives the share version a new copy has to
+  be captured against.
+*/
+SPIDER_CONFIG_CACHE *spider_config_cache_get(SPIDER_SHARE *share,
+                                             uint interval,
+                                             ulonglong *version) {
+  SPIDER_CONFIG_CACHE *cache = NULL;
+  time_t tmp_time = (time_t)time((time_t *)0);
+  DBUG_ENTER("spider_config_cache_get");
+  pthread_mutex_lock(&share->mutex);
+  if (share->config_cache &&
+      difftime(tmp_time, share->config_cache->load_time) < interval) {
+    cache = share->config_cache;
+    cache->ref_count++;
+  }
+  *version = share->config_cache_version;
+  pthread_mutex_unlock(&share->mutex);
+  DBUG_PRINT("info", ("spider cache=%p", cache));
+  DBUG_RETURN(cache);
+}
+
+void spider_config_cache_release(SPIDER_SHARE *share,
+                                 SPIDER_CONFIG_CACHE *cache) {
+  bool do_free;
+  DBUG_ENTER("spider_config_cache_release");
+  pthread_mutex_lock(&share->mutex);
+  do_free = !--cache->ref_count;
+  pthread_mutex_unlock(&share->mutex);
+  if (do_free) spider_free(spider_current_trx, cache, MYF(0));
+  DBUG_VOID_RETURN;
+}
+
+static int spider_config_cache_key_cmp(const void *keys, const void *row1,
+                                       const void *row2) {
+  /* keys is the NULL terminated KEY * array key_rec_cmp() walks */
+  KEY **key_info = (KEY **)keys;
+  return key_rec_cmp(key_info, *(uchar **)row1, *(uchar **)row2);
+}
+
+/*
+  Store a captured copy unless the table was written since the capture
+  started. The rows are sorted by every unique key without nullable parts
+  so that lookups can search them. The copy is skipped silently when memory
+  is short.
+*/
+void spider_config_cache_publish(SPIDER_SHARE *share, TABLE *table,
+                                 ulonglong version, const uchar *rows,
+                                 ha_rows records) {
+  SPIDER_CONFIG_CACHE *cache, *old_cache = NULL;
+  uint reclength = table->s->reclength, key_nr;
+  uchar *tmp_rows, **tmp_key_rows;
+  ha_rows roop_count;
+  KEY *keys[2];
+  DBUG_ENTER("spider_config_cache_publish");
+  if (!(cache = (SPIDER_CONFIG_CACHE *)spider_bulk_malloc(
+            spider_current_trx, 238, MYF(MY_WME), &cache,
+            sizeof(SPIDER_CONFIG_CACHE), &tmp_rows,
+            (uint)(records * reclength), &tmp_key_rows,
+            (uint)(records * table->s->keys * sizeof(uchar *)), NullS)))
+    DBUG_VOID_RETURN;
+  cache->ref_count = 1;
+  cache->load_time = (time_t)time((time_t *)0);
+  cache->records = records;
+  cache->reclength = reclength;
+  cache->rows = tmp_rows;
+  cache->key_rows = tmp_key_rows;
+  if (records) memcpy(tmp_rows, rows, (size_t)(records * reclength));
+  keys[1] = NULL;
+  for (key_nr = 0; key_nr < table->s->keys; key_nr++) {
+    if ((table->key_info[key_nr].flags & (HA_NOSAME | HA_NULL_PART_KEY)) !=
+        HA_NOSAME)
+      continue;
+    for (roop_count = 0; roop_count < records; roop_count++)
+      tmp_key_rows[key_nr * records + roop_count] =
+          tmp_rows + roop_count * reclength;
+    keys[0] = &table->key_info[key_nr];
+    my_qsort2(tmp_key_rows + key_nr * records, (size_t)records,
+              sizeof(uchar *), spider_config_cache_key_cmp, keys);
+  }
+  pthread_mutex_lock(&share->mutex);
+  if (version == share->config_cache_version) {
+    old_cache = share->config_cache;
+    share->config_cache = cache;
+    cache = NULL;
+  }
+  pthread_mutex_unlock(&share->mutex);
+  if (cache) spider_free(spider_current_trx, cache, MYF(0));
+  if (old_cache) spider_config_cache_release(share, old_cache);
+  DBUG_VOID_RETURN;
+}
+
+ha_checksum spider_range_estimate_hash(uint inx, key_range *start_key,
+                                       key_range *end_key) {
+  ha_checksum range_hash = (ha_checksum)inx;
+  uchar flags[2];
+  DBUG_ENTER("spider_range_estimate_hash");
+  flags[0] = start_key ? (uchar)start_key->flag + 1 : 0;
+  flags[1] = end_key ? (uchar)end_key->flag + 1 : 0;
+  range_hash = my_checksum(range_hash, flags, 2);
+  if (start_key)
+    range_hash = my_checksum(range_hash, start_key->key, start_key->length);
+  if (end_key)
+    range_hash = my_checksum(range_hash, end_key->key, end_key->length);
+  DBUG_RETURN(range_hash);
+}
+
+static bool spider_range_estimate_match(SPIDER_RANGE_ESTIMATE *estimate,
+                                        uint inx, key_range *start_key,
+                                        key_range *end_key,
+                                        ha_checksum range_hash) {
+  uint start_length = start_key ? start_key->length : 0;
+  uint end_length = end_key ? end_key->length : 0;
+  DBUG_ENTER("spider_range_estimate_match");
+  if (!estimate->get_time || estimate->inx != inx ||
+      estimate->range_hash != range_hash ||
+      estimate->start_flag != (start_key ? (uchar)start_key->flag + 1 : 0) ||
+      estimate->end_flag != (end_key ? (uchar)end_key->flag + 1 : 0) ||
+      estimate->start_length != start_length ||
+      estimate->key_length != start_length + end_length)
+    DBUG_RETURN(FALSE);
+  if ((start_length &&
+       memcmp(estimate->key, start_key->key, start_length)) ||
+      (end_length &&
+       memcmp(estimate->key + start_length, end_key->key, end_length)))
+    DBUG_RETURN(FALSE);
+  DBUG_RETURN(TRUE);
+}
+
+/*
+  Return the estimate cached for the same index and bounds within interval
+  seconds, or HA_POS_ERROR.
+*/
+ha_rows spider_get_range_estimate(SPIDER_SHARE *share, uint inx,
+                                  key_range *start_key, key_range *end_key,
+                                  ha_checksum range_hash, uint interval) {
+  ha_rows rows = HA_POS_ERROR;
+  SPIDER_RANGE_ESTIMATE *estimate;
+  time_t tmp_time = (time_t)time((time_t *)0);
+  DBUG_ENTER("spider_get_range_estimate");
+  pthread_mutex_lock(&share->crd_mutex);
+  if (share->range_estimates) {
+    estimate =
+        &share->range_estimates[range_hash % SPIDER_RANGE_ESTIMATE_SIZE];
+    if (spider_range_estimate_match(estimate, inx, start_key, end_key,
+                                    range_hash) &&
+        difftime(tmp_time, estimate->get_time) < interval)
+      rows = estimate->rows;
+  }
+  pthread_mutex_unlock(&share->crd_mutex);
+  DBUG_PRINT("info", ("spider rows=%llu", (ulonglong)rows));
+  DBUG_RETURN(rows);
+}
+
+void spider_set_range_estimate(SPIDER_SHARE *share, uint inx,
+                               key_range *start_key, key_range *end_key,
+                               ha_checksum range_hash, ha_rows rows) {
+  SPIDER_RANGE_ESTIMATE *estimate;
+  uint start_length = start_key ? start_key->length : 0;
+  uint end_length = end_key ? end_key->length : 0;
+  uchar *key = NULL;
+  DBUG_ENTER("spider_set_range_estimate");
+  if (start_length + end_length &&
+      !(key = (uchar *)spider_malloc(spider_current_trx, 233,
+                                     start_length + end_length, MYF(MY_WME))))
+    DBUG_VOID_RETURN;
+  if (start_length) memcpy(key, start_key->key, start_length);
+  if (end_length) memcpy(key + start_length, end_key->key, end_length);
+  pthread_mutex_lock(&share->crd_mutex);
+  if (!share->range_estimates &&
+      !(share->range_estimates = (SPIDER_RANGE_ESTIMATE *)spider_malloc(
+            spider_current_trx, 232,
+            sizeof(SPIDER_RANGE_ESTIMATE) * SPIDER_RANGE_ESTIMATE_SIZE,
+            MYF(MY_WME | MY_ZEROFILL)))) {
+    pthread_mutex_unlock(&share->crd_mutex);
+    if (key) spider_free(spider_current_trx, key, MYF(0));
+    DBUG_VOID_RETURN;
+  }
+  estimate = &share->range_estimates[range_hash % SPIDER_RANGE_ESTIMATE_SIZE];
+  if (estimate->key) spider_free(spider_current_trx, estimate->key, MYF(0));
+  estimate->inx = inx;
+  estimate->range_hash = range_hash;
+  estimate->get_time = (time_t)time((time_t *)0);
+  estimate->rows = rows;
+  estimate->key = key;
+  estimate->key_length = start_length + end_length;
+  estimate->start_length = start_length;
+  estimate->start_flag = start_key ? (uchar)start_key->flag + 1 : 0;
+  estimate->end_flag = end_key ? (uchar)end_key->flag + 1 : 0;
+  pthread_mutex_unlock(&share->crd_mutex);
+  DBUG_VOID_RETURN;
+}
+
+void spider_free_range_estimates(SPIDER_SHARE *share) {
+  int roop_count;
+  DBUG_ENTER("spider_free_range_estimates");
+  if (share->range_estimates) {
+    for (roop_count = 0; roop_count < SPIDER_RANGE_ESTIMATE_SIZE;
+         roop_count++) {
+      if (share->range_estimates[roop_count].key)
+        spider_free(spider_current_trx,
+                    share->range_estimates[roop_count].key, MYF(0));
+    }
+    spider_free(spider_current_trx, share->range_estimates, MYF(0));
+    share->range_estimates = NULL;
+  }
+  DBUG_VOID_RETURN;
+}
+
+void spider_config_cache_invalidate(SPIDER_SHARE *share) {
+  SPIDER_CONFIG_CACHE *cache;
+  DBUG_ENTER("spider_config_cache_invalidate");
+  pthread_mutex_lock(&share->mutex);
+  share->config_cache_version++;
+  cache = share->config_cache;
+  share->config_cache = NULL;
+  pthread_mutex_unlock(&share->mutex);
+  if (cache) spider_config_cache_release(share, cache);
+  DBUG_VOID_RETURN;
+}
+
 void spider_update_link_status_for_share(const char *table_name,
                                          uint table_name_length, int link_idx,
                                          long link_status) {
@@ -4947,6 +5202,7 @@ int spider_db_done(void *p) {
   }
 
   spider_free_get_status_thread();
+  spider_free_conn_pool_maintain_thread();
   for (roop_count = SPIDER_DBTON_SIZE - 1; roop_count >= 0; roop_count--) {
     if (spider_dbton[roop_count].deinit) {
       spider_dbton[roop_count].deinit();
@@ -5028,6 +5284,7 @@ int spider_db_done(void *p) {
                        spider_lgtm_tblhnd_share_hash.array.max_element *
                            spider_lgtm_tblhnd_share_hash.array.size_of_element);
   my_hash_free(&spider_lgtm_tblhnd_share_hash);
+  my_hash_free(&spider_sys_stats_preload_hash);
 #ifdef WITH_PARTITION_STORAGE_ENGINE
   spider_free_mem_calc(spider_current_trx, spider_open_pt_share_id,
                        spider_open_pt_share.array.max_element *
@@ -5054,6 +5311,7 @@ int spider_db_done(void *p) {
   pthread_mutex_destroy(&spider_allocated_thds_mutex);
   pthread_mutex_destroy(&spider_open_conn_mutex);
   // pthread_mutex_destroy(&spider_conn_mutex);
+  pthread_mutex_destroy(&spider_sys_stats_preload_mutex);
   pthread_mutex_destroy(&spider_lgtm_tblhnd_share_mutex);
 #ifdef WITH_PARTITION_STORAGE_ENGINE
   pthread_mutex_destroy(&spider_pt_share_mutex);
@@ -5330,6 +5588,16 @@ int spider_db_init(void *p) {
     error_num = HA_ERR_OUT_OF_MEM;
     goto error_lgtm_tblhnd_share_mutex_init;
   }
+#if MYSQL_VERSION_ID < 50500
+  if (pthread_mutex_init(&spider_sys_stats_preload_mutex, MY_MUTEX_INIT_FAST))
+#else
+  if (mysql_mutex_init(spd_key_mutex_sys_stats_preload,
+                       &spider_sys_stats_preload_mutex, MY_MUTEX_INIT_FAST))
+#endif
+  {
+    error_num = HA_ERR_OUT_OF_MEM;
+    goto error_sys_stats_preload_mutex_init;
+  }
   if (spd_connect_pools.init((my_hash_get_key)spider_conn_pool_get_key,
       SPIDER_CONN_POOL_HASH_INIT_SIZE, spd_charset_utf8_bin))
 // #if MYSQL_VERSION_ID < 50500
@@ -5428,6 +5696,12 @@ int spider_db_init(void *p) {
       NULL, spider_lgtm_tblhnd_share_hash,
       spider_lgtm_tblhnd_share_hash.array.max_element *
           spider_lgtm_tblhnd_share_hash.array.size_of_element);
+  if (my_hash_init(&spider_sys_stats_preload_hash, spd_charset_utf8_bin, 32, 0,
+                   0, (my_hash_get_key)spider_sys_stats_preload_get_key,
+                   spider_sys_stats_preload_free, 0)) {
+    error_num = HA_ERR_OUT_OF_MEM;
+    goto error_sys_stats_preload_hash_init;
+  }
   // if (my_hash_init(&spider_open_connections, spd_charset_utf8_bin, 256, 0, 0,
   //                  (my_hash_get_key)spider_conn_get_key, 0, 0)) {
   //   error_num = HA_ERR_OUT_OF_MEM;
@@ -5540,6 +5814,9 @@ int spider_db_init(void *p) {
   if (error_num = spider_create_get_status_thread()) {
     goto error_conn_get_status_thd_init;
   }
+  if ((error_num = spider_create_conn_pool_maintain_thread())) {
+    goto error_conn_pool_maintain_thd_init;
+  }
 
   spider_dbton_mysql.dbton_id = dbton_id;
   spider_dbton[dbton_id] = spider_dbton_mysql;
@@ -5569,6 +5846,8 @@ int spider_db_init(void *p) {
   }
   roop_count = spider_param_udf_table_mon_mutex_count() - 1;
 #endif
+error_conn_pool_maintain_thd_init:
+  spider_free_conn_pool_maintain_thread();
 error_conn_recycle_thd_init:
   spider_free_conn_recycle_thread();
 error_conn_get_status_thd_init:
@@ -5614,6 +5893,8 @@ int spider_db_init(void *p) {
 error_conn_meta_hash_init:
   // my_hash_free(&spider_open_connections);
 error_open_connections_hash_init:
+  my_hash_free(&spider_sys_stats_preload_hash);
+error_sys_stats_preload_hash_init:
   spider_free_mem_calc(NULL, spider_lgtm_tblhnd_share_hash_id,
                        spider_lgtm_tblhnd_share_hash.array.max_element *
                            spider_lgtm_tblhnd_share_hash.array.size_of_element);
@@ -5648,6 +5929,8 @@ int spider_db_init(void *p) {
 error_conn_meta_mutex_init:
   spd_connect_pools.destroy();
 error_conn_mutex_init:
+  pthread_mutex_destroy(&spider_sys_stats_preload_mutex);
+error_sys_stats_preload_mutex_init:
   pthread_mutex_destroy(&spider_lgtm_tblhnd_share_mutex);
 error_lgtm_tblhnd_share_mutex_init:
 #ifdef WITH_PARTITION_STORAGE_ENGINE
@@ -6201,6 +6484,7 @@ void spider_set_tmp_share_pointer(SPIDER_SHARE *tmp_share,
   tmp_long[15] = -1;
   tmp_share->access_balances = &tmp_long[17];
   tmp_share->bka_table_name_types = &tmp_long[18];
+  tmp_share->net_compresses = &tmp_long[19];
   tmp_share->monitoring_limit = &tmp_longlong[0];
   tmp_share->monitoring_sid = &tmp_longlong[1];
   tmp_share->monitoring_bg_interval = &tmp_longlong[2];
@@ -6255,6 +6539,7 @@ void spider_set_tmp_share_pointer(SPIDER_SHARE *tmp_share,
   tmp_share->connect_timeouts_length = 1;
   tmp_share->net_read_timeouts_length = 1;
   tmp_share->net_write_timeouts_length = 1;
+  tmp_share->net_compresses_length = 1;
   tmp_share->access_balances_length = 1;
   tmp_share->bka_table_name_types_length = 1;
 
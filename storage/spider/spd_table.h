@@ -319,6 +319,32 @@ void spider_free_share_resource_only(SPIDER_SHARE *share);
 
 int spider_free_share(SPIDER_SHARE *share);
 
+SPIDER_CONFIG_CACHE *spider_config_cache_get(SPIDER_SHARE *share,
+                                             uint interval,
+                                             ulonglong *version);
+
+void spider_config_cache_release(SPIDER_SHARE *share,
+                                 SPIDER_CONFIG_CACHE *cache);
+
+void spider_config_cache_publish(SPIDER_SHARE *share, TABLE *table,
+                                 ulonglong version, const uchar *rows,
+                                 ha_rows records);
+
+void spider_config_cache_invalidate(SPIDER_SHARE *share);
+
+ha_checksum spider_range_estimate_hash(uint inx, key_range *start_key,
+                                       key_range *end_key);
+
+ha_rows spider_get_range_estimate(SPIDER_SHARE *share, uint inx,
+                                  key_range *start_key, key_range *end_key,
+                                  ha_checksum range_hash, uint interval);
+
+void spider_set_range_estimate(SPIDER_SHARE *share, uint inx,
+                               key_range *start_key, key_range *end_key,
+                               ha_checksum range_hash, ha_rows rows);
+
+void spider_free_range_estimates(SPIDER_SHARE *share);
+
 void spider_update_link_status_for_share(const char *table_name,
                                          uint table_name_length, int link_idx,
                                          long link_status);
@@ -92,7 +92,8 @@ int spider_free_trx_conn(SPIDER_TRX *trx, bool trx_free) {
   SPIDER_CONN *conn;
   DBUG_ENTER("spider_free_trx_conn");
   roop_count = 0;
-  if (trx_free || spider_param_conn_recycle_mode(trx->thd) != 2) {
+  if (trx_free || spider_param_conn_recycle_mode(trx->thd) != 2 ||
+      spider_conn_multiplexed(trx->thd)) {
     while ((conn = (SPIDER_CONN *)my_hash_element(&trx->trx_conn_hash,
                                                   roop_count))) {
       spider_conn_clear_queue_at_commit(conn);
@@ -1356,8 +1357,10 @@ int spider_internal_start_trx(ha_spider *spider, SPIDER_CONN *conn,
   int error_num;
   SPIDER_TRX *trx = spider->trx;
   THD *thd = trx->thd;
-  bool sync_autocommit = spider_param_sync_autocommit(thd);
-  bool sync_time_zone = spider_param_sync_time_zone(thd);
+  /* a multiplexed connection may carry the state of another session */
+  bool multiplex = spider_conn_multiplexed(thd);
+  bool sync_autocommit = spider_param_sync_autocommit(thd) || multiplex;
+  bool sync_time_zone = spider_param_sync_time_zone(thd) || multiplex;
   double ping_interval_at_trx_start =
       spider_param_ping_interval_at_trx_start(thd);
   bool xa_lock = FALSE;
@@ -1929,6 +1932,7 @@ int spider_free_prepared_trx(THD *thd, SPIDER_TRX *trx) {
       conn_next = spider_tree_next(conn);
       spider_tree_delete(conn, trx->join_trx_top);
       my_hash_delete(&trx->trx_conn_hash, (uchar *)conn);
+      spider_stmt_unbind_conn(trx, conn);
       spider_free_conn(conn);
       conn = conn_next;
     } while (conn);